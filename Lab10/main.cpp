@@ -1,173 +1,1140 @@
-#include <iostream>
-#include <string>
-#include <vector>
-#include <windows.h>
-using namespace std;
-
-// === Інтерфейс Посередника ===
-class Mediator {
-public:
-    virtual void notify(string sender, string event) = 0;
-};
-
-// === Базовий клас Компонента ===
-class Component {
-protected:
-    Mediator* mediator;
-
-public:
-    void setMediator(Mediator* m) { mediator = m; }
-    virtual ~Component() = default;
-};
-
-// === Конкретні елементи форми ===
-
-// 1️Вибір дати доставки
-class DeliveryDatePicker : public Component {
-    string date;
-public:
-    void selectDate(string newDate) {
-        date = newDate;
-        cout << "[Дата доставки] Обрано: " << date << endl;
-        mediator->notify("DeliveryDate", "DateChanged");
-    }
-    string getDate() const { return date; }
-};
-
-// 2️Вибір проміжку часу
-class TimeSlotSelector : public Component {
-    vector<string> availableSlots;
-public:
-    void updateAvailableSlots(vector<string> slots) {
-        availableSlots = slots;
-        cout << "[Час доставки] Доступні слоти оновлено: ";
-        for (auto& s : availableSlots) cout << s << " ";
-        cout << endl;
-    }
-};
-
-// 3️Чекбокс “Отримувач інша особа”
-class OtherPersonCheckbox : public Component {
-    bool checked = false;
-public:
-    void toggle(bool state) {
-        checked = state;
-        cout << "[Отримувач інша особа] Стан: " << (checked ? "Так" : "Ні") << endl;
-        mediator->notify("OtherPersonCheckbox", "Toggled");
-    }
-    bool isChecked() const { return checked; }
-};
-
-// 4️Поля Ім’я та Телефон
-class RecipientNameField : public Component {
-public:
-    void setVisible(bool visible) {
-        cout << "[Поле Ім’я] " << (visible ? "Показано" : "Сховано") << endl;
-    }
-};
-
-class RecipientPhoneField : public Component {
-public:
-    void setVisible(bool visible) {
-        cout << "[Поле Телефон] " << (visible ? "Показано" : "Сховано") << endl;
-    }
-};
-
-// 5️Чекбокс “Самовивіз”
-class PickupCheckbox : public Component {
-    bool checked = false;
-public:
-    void toggle(bool state) {
-        checked = state;
-        cout << "[Самовивіз] Стан: " << (checked ? "Так" : "Ні") << endl;
-        mediator->notify("PickupCheckbox", "Toggled");
-    }
-    bool isChecked() const { return checked; }
-};
-
-// === Конкретний Посередник ===
-class OrderFormMediator : public Mediator {
-private:
-    DeliveryDatePicker* datePicker;
-    TimeSlotSelector* timeSelector;
-    OtherPersonCheckbox* otherCheckbox;
-    RecipientNameField* nameField;
-    RecipientPhoneField* phoneField;
-    PickupCheckbox* pickupCheckbox;
-
-public:
-    OrderFormMediator(DeliveryDatePicker* d, TimeSlotSelector* t,
-                      OtherPersonCheckbox* o, RecipientNameField* n,
-                      RecipientPhoneField* p, PickupCheckbox* pick) :
-                      datePicker(d), timeSelector(t),
-                      otherCheckbox(o), nameField(n),
-                      phoneField(p), pickupCheckbox(pick) {
-        d->setMediator(this);
-        t->setMediator(this);
-        o->setMediator(this);
-        n->setMediator(this);
-        p->setMediator(this);
-        pick->setMediator(this);
-    }
-
-    void notify(string sender, string event) override {
-        if (sender == "DeliveryDate" && event == "DateChanged") {
-            // При зміні дати — оновлюємо доступні часові слоти
-            cout << "[Посередник] Оновлюємо часові слоти відповідно до дати.\n";
-            if (datePicker->getDate() == "Сьогодні")
-                timeSelector->updateAvailableSlots({"12:00", "14:00", "16:00"});
-            else
-                timeSelector->updateAvailableSlots({"10:00", "12:00", "15:00", "18:00"});
-        }
-
-        else if (sender == "OtherPersonCheckbox" && event == "Toggled") {
-            // Якщо “отримувач інша особа” — показуємо додаткові поля
-            bool state = otherCheckbox->isChecked();
-            nameField->setVisible(state);
-            phoneField->setVisible(state);
-        }
-
-        else if (sender == "PickupCheckbox" && event == "Toggled") {
-            // Якщо “самовивіз” — блокуємо поля доставки
-            bool state = pickupCheckbox->isChecked();
-            cout << "[Посередник] Самовивіз: " << (state ? "Вимикаємо доставку." : "Увімкнено доставку.") << endl;
-            if (state) {
-                timeSelector->updateAvailableSlots({});
-                nameField->setVisible(false);
-                phoneField->setVisible(false);
-            }
-        }
-    }
-};
-
-// === Клієнтський код ===
-int main() {
-    SetConsoleOutputCP(65001);
-
-    // Створюємо елементи форми
-    DeliveryDatePicker date;
-    TimeSlotSelector timeSlots;
-    OtherPersonCheckbox otherPerson;
-    RecipientNameField nameField;
-    RecipientPhoneField phoneField;
-    PickupCheckbox pickup;
-
-    // Створюємо посередника
-    OrderFormMediator mediator(&date, &timeSlots, &otherPerson, &nameField, &phoneField, &pickup);
-
-    cout << "\n=== Демонстрація роботи патерну Посередник ===\n\n";
-
-    // 1. Користувач обирає дату доставки
-    date.selectDate("Сьогодні");
-
-    // 2. Користувач вказує, що отримувач інша особа
-    otherPerson.toggle(true);
-
-    // 3. Користувач передумав — сам забере квіти
-    pickup.toggle(true);
-
-    // 4. Потім знову передумав — хоче доставку
-    pickup.toggle(false);
-
-    return 0;
-}
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <algorithm>
+#include <array>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "../common/alloc_counter.h"
+
+using namespace std;
+
+// Інтерновані ідентифікатори відправників і подій
+using EventId = uint16_t;
+
+// === Інтерфейс Посередника ===
+class Mediator {
+    bool verbose = true;
+
+public:
+    // Інтернування назв — лише при реєстрації компонентів і обробників
+    virtual EventId senderId(const string& name) = 0;
+    virtual EventId eventId(const string& name) = 0;
+
+    // Швидкий шлях: цілі ідентифікатори, без рядків і виділень пам'яті
+    virtual void notify(EventId sender, EventId event) = 0;
+    // Рядковий API для сумісності
+    virtual void notify(string sender, string event) = 0;
+
+    void setVerbose(bool v) { verbose = v; }
+    ostream& log() {
+        // Один порожній потік на потік виконання, а не на кожного посередника
+        static thread_local ostream silent{nullptr};
+        return verbose ? cout : silent;
+    }
+
+    virtual ~Mediator() = default;
+};
+
+// === Базовий клас Компонента ===
+class Component {
+protected:
+    Mediator* mediator = nullptr;
+
+    // Викликається після підключення до посередника: тут компонент інтернує свої назви
+    virtual void attached() {}
+
+public:
+    void setMediator(Mediator* m) {
+        mediator = m;
+        attached();
+    }
+    virtual ~Component() = default;
+};
+
+// === Таблиця назв: рядок <-> ціле число ===
+class NameTable {
+    unordered_map<string, EventId> ids;
+    vector<string> names;
+
+public:
+    EventId intern(const string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end())
+            return it->second;
+        names.push_back(name);
+        ids.emplace(name, (EventId)(names.size() - 1));
+        return (EventId)(names.size() - 1);
+    }
+
+    bool find(const string& name, EventId& id) const {
+        auto it = ids.find(name);
+        if (it == ids.end())
+            return false;
+        id = it->second;
+        return true;
+    }
+
+    const string& name(EventId id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+};
+
+// === Таблиця диспетчеризації: (відправник, подія) -> обробники ===
+// Заповнюється під час реєстрації; dispatch лише індексує плаский масив.
+template <typename Target>
+class DispatchTable {
+public:
+    using Handler = function<void(Target&)>;
+
+private:
+    NameTable senders;
+    NameTable events;
+    size_t stride = 0;              // кількість стовпців (подій) у таблиці
+    vector<vector<Handler>> slots;  // [sender * stride + event]
+
+    // Перебудовує таблицю, якщо з'явилися нові відправники чи події
+    void fit() {
+        if (events.size() <= stride && senders.size() * stride <= slots.size())
+            return;
+        size_t newStride = max(stride, events.size());
+        vector<vector<Handler>> resized(senders.size() * newStride);
+        for (size_t s = 0; stride && s < slots.size() / stride; ++s)
+            for (size_t e = 0; e < stride; ++e)
+                resized[s * newStride + e] = move(slots[s * stride + e]);
+        slots = move(resized);
+        stride = newStride;
+    }
+
+public:
+    EventId sender(const string& name) { EventId id = senders.intern(name); fit(); return id; }
+    EventId event(const string& name) { EventId id = events.intern(name); fit(); return id; }
+    bool findSender(const string& name, EventId& id) const { return senders.find(name, id); }
+    bool findEvent(const string& name, EventId& id) const { return events.find(name, id); }
+
+    void on(const string& senderName, const string& eventName, Handler handler) {
+        EventId s = sender(senderName), e = event(eventName);
+        slots[s * stride + e].push_back(move(handler));
+    }
+
+    void dispatch(Target& target, EventId sender, EventId event) const {
+        if (event >= stride || sender * stride + event >= slots.size())
+            return;
+        for (auto& handler : slots[sender * stride + event])
+            handler(target);
+    }
+};
+
+// === Індекс доступності часових слотів ===
+// Календар: для кожної дати — слоти з лічильником вільних місць (місткість кур'єрів).
+// Дати і слоти додаються до початку роботи; після цього reserve/release змінюють
+// лише атомарні лічильники (цикл compare-exchange без блокувань), тому слот
+// неможливо забронювати понад місткість. Запит доступних слотів не виділяє пам'ять.
+class SlotAvailabilityIndex {
+public:
+    // Стільки слотів вміщує TimeSlotSelector; дата з більшою кількістю відхиляється
+    static constexpr size_t MAX_SLOTS = 8;
+
+    struct SlotCapacity {
+        string label;
+        int capacity;
+    };
+
+private:
+    // Окрема кеш-лінія на лічильник: бронювання різних слотів не заважають одне одному
+    struct alignas(64) Counter {
+        atomic<int> remaining{0};
+        int capacity = 0;
+    };
+
+    struct Day {
+        vector<string> labels;
+        unique_ptr<Counter[]> counters;
+    };
+
+    vector<Day> days;
+    unordered_map<string, size_t> dateIndex;
+
+public:
+    size_t addDate(const string& date, const vector<SlotCapacity>& slots) {
+        if (dateIndex.count(date))
+            throw invalid_argument("Дату вже додано: " + date);
+        if (slots.size() > MAX_SLOTS)
+            throw length_error("Забагато слотів для дати " + date + ": " + to_string(slots.size()) +
+                               " (не більше " + to_string(MAX_SLOTS) + ")");
+        Day day;
+        day.counters.reset(new Counter[slots.size()]);
+        for (size_t i = 0; i < slots.size(); ++i) {
+            day.labels.push_back(slots[i].label);
+            day.counters[i].capacity = slots[i].capacity;
+            day.counters[i].remaining.store(slots[i].capacity, memory_order_relaxed);
+        }
+        days.push_back(move(day));
+        dateIndex.emplace(date, days.size() - 1);
+        return days.size() - 1;
+    }
+
+    bool findDate(const string& date, size_t& index) const {
+        auto it = dateIndex.find(date);
+        if (it == dateIndex.end())
+            return false;
+        index = it->second;
+        return true;
+    }
+
+    size_t slotCount(size_t date) const { return days[date].labels.size(); }
+    const string& slotLabel(size_t date, size_t slot) const { return days[date].labels[slot]; }
+    int remaining(size_t date, size_t slot) const {
+        return days[date].counters[slot].remaining.load(memory_order_acquire);
+    }
+
+    // false — вільних місць немає
+    bool reserve(size_t date, size_t slot) {
+        atomic<int>& remaining = days[date].counters[slot].remaining;
+        int current = remaining.load(memory_order_relaxed);
+        while (current > 0)
+            if (remaining.compare_exchange_weak(current, current - 1, memory_order_acq_rel))
+                return true;
+        return false;
+    }
+
+    // false — слот і так повністю вільний (зайве скасування)
+    bool release(size_t date, size_t slot) {
+        Counter& counter = days[date].counters[slot];
+        int current = counter.remaining.load(memory_order_relaxed);
+        while (current < counter.capacity)
+            if (counter.remaining.compare_exchange_weak(current, current + 1, memory_order_acq_rel))
+                return true;
+        return false;
+    }
+
+    // Записує в out вказівники на назви слотів із вільними місцями; повертає їх кількість
+    size_t availableSlots(size_t date, const string** out, size_t maxCount) const {
+        const Day& day = days[date];
+        size_t count = 0;
+        for (size_t i = 0; i < day.labels.size() && count < maxCount; ++i)
+            if (day.counters[i].remaining.load(memory_order_acquire) > 0)
+                out[count++] = &day.labels[i];
+        return count;
+    }
+};
+
+// === Конкретні елементи форми ===
+
+// 1️Вибір дати доставки
+class DeliveryDatePicker : public Component {
+    string date;
+    EventId self = 0, dateChanged = 0;
+
+protected:
+    void attached() override {
+        self = mediator->senderId("DeliveryDate");
+        dateChanged = mediator->eventId("DateChanged");
+    }
+
+public:
+    void selectDate(const string& newDate) {
+        date = newDate;
+        mediator->log() << "[Дата доставки] Обрано: " << date << "\n";
+        mediator->notify(self, dateChanged);
+    }
+    const string& getDate() const { return date; }
+};
+
+// 2️Вибір проміжку часу
+// Назви слотів незмінні і спільні для всіх форм (списки посередника або індекс
+// доступності), тому компонент зберігає лише вказівники на них; викликач гарантує,
+// що назви живуть довше за компонент
+class TimeSlotSelector : public Component {
+public:
+    static constexpr size_t MAX_SLOTS = SlotAvailabilityIndex::MAX_SLOTS;
+
+private:
+    array<const string*, MAX_SLOTS> availableSlots{};
+    size_t slotCount = 0;
+
+public:
+    void updateAvailableSlots(const string* const* slots, size_t count) {
+        if (count > MAX_SLOTS)
+            throw length_error("Забагато часових слотів: " + to_string(count));
+        slotCount = count;
+        copy(slots, slots + slotCount, availableSlots.begin());
+        ostream& out = mediator->log();
+        out << "[Час доставки] Доступні слоти оновлено: ";
+        for (size_t i = 0; i < slotCount; ++i) out << *availableSlots[i] << " ";
+        out << "\n";
+    }
+
+    size_t getSlotCount() const { return slotCount; }
+    const string& getSlot(size_t i) const { return *availableSlots[i]; }
+
+    bool hasSlots(const string* const* slots, size_t count) const {
+        return count == slotCount && equal(slots, slots + count, availableSlots.begin());
+    }
+};
+
+// 3️Чекбокс “Отримувач інша особа”
+class OtherPersonCheckbox : public Component {
+    bool checked = false;
+    EventId self = 0, toggled = 0;
+
+protected:
+    void attached() override {
+        self = mediator->senderId("OtherPersonCheckbox");
+        toggled = mediator->eventId("Toggled");
+    }
+
+public:
+    void toggle(bool state) {
+        checked = state;
+        mediator->log() << "[Отримувач інша особа] Стан: " << (checked ? "Так" : "Ні") << "\n";
+        mediator->notify(self, toggled);
+    }
+    bool isChecked() const { return checked; }
+};
+
+// 4️Поля Ім’я та Телефон
+class RecipientNameField : public Component {
+    bool visible = false;
+public:
+    void setVisible(bool v) {
+        visible = v;
+        mediator->log() << "[Поле Ім’я] " << (visible ? "Показано" : "Сховано") << "\n";
+    }
+    bool isVisible() const { return visible; }
+};
+
+class RecipientPhoneField : public Component {
+    bool visible = false;
+public:
+    void setVisible(bool v) {
+        visible = v;
+        mediator->log() << "[Поле Телефон] " << (visible ? "Показано" : "Сховано") << "\n";
+    }
+    bool isVisible() const { return visible; }
+};
+
+// 5️Чекбокс “Самовивіз”
+class PickupCheckbox : public Component {
+    bool checked = false;
+    EventId self = 0, toggled = 0;
+
+protected:
+    void attached() override {
+        self = mediator->senderId("PickupCheckbox");
+        toggled = mediator->eventId("Toggled");
+    }
+
+public:
+    void toggle(bool state) {
+        checked = state;
+        mediator->log() << "[Самовивіз] Стан: " << (checked ? "Так" : "Ні") << "\n";
+        mediator->notify(self, toggled);
+    }
+    bool isChecked() const { return checked; }
+};
+
+// === Конкретний Посередник ===
+// Правила форми зберігаються в таблиці диспетчеризації, спільній для всіх
+// посередників; реєстрація нового обробника робить посереднику власну копію.
+class OrderFormMediator : public Mediator {
+public:
+    using Rules = DispatchTable<OrderFormMediator>;
+
+private:
+    DeliveryDatePicker* datePicker;
+    TimeSlotSelector* timeSelector;
+    OtherPersonCheckbox* otherCheckbox;
+    RecipientNameField* nameField;
+    RecipientPhoneField* phoneField;
+    PickupCheckbox* pickupCheckbox;
+    shared_ptr<const Rules> rules;
+    const SlotAvailabilityIndex* slotIndex = nullptr;
+
+    // Пакетний режим: правила виконуються під час події, але залежні компоненти
+    // не змінюються — чернетка запам'ятовує лише, звідки брати їхнє значення
+    enum class Source : uint8_t { Unchanged, FromState, Explicit };
+    int batchDepth = 0;
+    Source stagedSlotSource = Source::Unchanged;      // FromState — слоти за датою
+    array<const string*, TimeSlotSelector::MAX_SLOTS> stagedSlots{};
+    size_t stagedSlotCount = 0;
+    Source stagedRecipientSource = Source::Unchanged; // FromState — за чекбоксом отримувача
+    bool stagedRecipient = false;
+    size_t appliedUpdates = 0;                        // скільки разів змінено залежні компоненти
+
+    // Незмінні списки слотів, щоб обробники не будували їх на кожну подію
+    static const vector<string>& todaySlots() { static const vector<string> s{"12:00", "14:00", "16:00"}; return s; }
+    static const vector<string>& regularSlots() { static const vector<string> s{"10:00", "12:00", "15:00", "18:00"}; return s; }
+    static const vector<string>& noSlots() { static const vector<string> s; return s; }
+
+    Rules& mutableRules() {
+        if (rules.use_count() > 1)
+            rules = make_shared<Rules>(*rules);
+        return const_cast<Rules&>(*rules);
+    }
+
+    // Слоти для поточної дати: з індексу доступності (лише з вільною місткістю)
+    // або фіксований список; out — буфер викликача, без виділень пам'яті
+    size_t slotsForDate(array<const string*, TimeSlotSelector::MAX_SLOTS>& out) const {
+        size_t day;
+        if (slotIndex && slotIndex->findDate(datePicker->getDate(), day))
+            return slotIndex->availableSlots(day, out.data(), out.size());
+        const vector<string>& fixed = datePicker->getDate() == "Сьогодні" ? todaySlots() : regularSlots();
+        for (size_t i = 0; i < fixed.size(); ++i)
+            out.at(i) = &fixed[i];
+        return fixed.size();
+    }
+
+    // Зміни залежних компонентів: одразу або, в пакеті, у чернетку
+    void showSlots(const string* const* slots, size_t count) {
+        if (batchDepth > 0) {
+            if (count > stagedSlots.size())
+                throw length_error("Забагато часових слотів: " + to_string(count));
+            stagedSlotSource = Source::Explicit;
+            stagedSlotCount = count;
+            copy(slots, slots + count, stagedSlots.begin());
+            return;
+        }
+        timeSelector->updateAvailableSlots(slots, count);
+        ++appliedUpdates;
+    }
+
+    // Лише для незмінних статичних списків вище: компонент зберігає вказівники на назви
+    void showSlots(const vector<string>& slots) {
+        array<const string*, TimeSlotSelector::MAX_SLOTS> pointers;
+        for (size_t i = 0; i < slots.size(); ++i)
+            pointers.at(i) = &slots[i];
+        showSlots(pointers.data(), slots.size());
+    }
+
+    // У пакеті список не будується: значення "слоти за датою" обчислюється при фіксації
+    void showSlotsForDate() {
+        if (batchDepth > 0) {
+            stagedSlotSource = Source::FromState;
+            return;
+        }
+        array<const string*, TimeSlotSelector::MAX_SLOTS> available;
+        showSlots(available.data(), slotsForDate(available));
+    }
+
+    void showRecipientFields(bool visible) {
+        if (batchDepth > 0) {
+            stagedRecipientSource = Source::Explicit;
+            stagedRecipient = visible;
+            return;
+        }
+        nameField->setVisible(visible);
+        phoneField->setVisible(visible);
+        appliedUpdates += 2;
+    }
+
+    void showRecipientFieldsForOtherPerson() {
+        if (batchDepth > 0) {
+            stagedRecipientSource = Source::FromState;
+            return;
+        }
+        showRecipientFields(otherCheckbox->isChecked());
+    }
+
+    // Обчислює значення з чернетки за підсумковим станом форми і застосовує
+    // лише ті, що відрізняються від поточного стану компонентів
+    void applyStaged() {
+        if (stagedSlotSource == Source::FromState)
+            stagedSlotCount = slotsForDate(stagedSlots);
+        if (stagedSlotSource != Source::Unchanged && !timeSelector->hasSlots(stagedSlots.data(), stagedSlotCount)) {
+            timeSelector->updateAvailableSlots(stagedSlots.data(), stagedSlotCount);
+            ++appliedUpdates;
+        }
+        if (stagedRecipientSource == Source::FromState)
+            stagedRecipient = otherCheckbox->isChecked();
+        if (stagedRecipientSource != Source::Unchanged) {
+            if (nameField->isVisible() != stagedRecipient) {
+                nameField->setVisible(stagedRecipient);
+                ++appliedUpdates;
+            }
+            if (phoneField->isVisible() != stagedRecipient) {
+                phoneField->setVisible(stagedRecipient);
+                ++appliedUpdates;
+            }
+        }
+        stagedSlotSource = Source::Unchanged;
+        stagedRecipientSource = Source::Unchanged;
+    }
+
+    void onDateChanged() {
+        // При зміні дати — оновлюємо доступні часові слоти
+        log() << "[Посередник] Оновлюємо часові слоти відповідно до дати.\n";
+        showSlotsForDate();
+    }
+
+    void onOtherPersonToggled() {
+        // Якщо “отримувач інша особа” — показуємо додаткові поля
+        showRecipientFieldsForOtherPerson();
+    }
+
+    void onPickupToggled() {
+        // Якщо “самовивіз” — блокуємо поля доставки
+        bool state = pickupCheckbox->isChecked();
+        log() << "[Посередник] Самовивіз: " << (state ? "Вимикаємо доставку." : "Увімкнено доставку.") << "\n";
+        if (state) {
+            showSlots(noSlots());
+            showRecipientFields(false);
+        }
+    }
+
+public:
+    // Стандартні правила форми; таблиця створюється один раз на процес
+    static shared_ptr<const Rules> defaultRules() {
+        static const shared_ptr<const Rules> shared = [] {
+            auto r = make_shared<Rules>();
+            r->on("DeliveryDate", "DateChanged", [](OrderFormMediator& m) { m.onDateChanged(); });
+            r->on("OtherPersonCheckbox", "Toggled", [](OrderFormMediator& m) { m.onOtherPersonToggled(); });
+            r->on("PickupCheckbox", "Toggled", [](OrderFormMediator& m) { m.onPickupToggled(); });
+            return shared_ptr<const Rules>(r);
+        }();
+        return shared;
+    }
+
+    OrderFormMediator(DeliveryDatePicker* d, TimeSlotSelector* t,
+                      OtherPersonCheckbox* o, RecipientNameField* n,
+                      RecipientPhoneField* p, PickupCheckbox* pick,
+                      shared_ptr<const Rules> r = defaultRules()) :
+                      datePicker(d), timeSelector(t),
+                      otherCheckbox(o), nameField(n),
+                      phoneField(p), pickupCheckbox(pick), rules(move(r)) {
+        d->setMediator(this);
+        t->setMediator(this);
+        o->setMediator(this);
+        n->setMediator(this);
+        p->setMediator(this);
+        pick->setMediator(this);
+    }
+
+    EventId senderId(const string& name) override {
+        EventId id;
+        return rules->findSender(name, id) ? id : mutableRules().sender(name);
+    }
+
+    EventId eventId(const string& name) override {
+        EventId id;
+        return rules->findEvent(name, id) ? id : mutableRules().event(name);
+    }
+
+    // Індекс доступності слотів; без нього діють фіксовані списки
+    void setSlotIndex(const SlotAvailabilityIndex* index) { slotIndex = index; }
+
+    // Додатковий обробник пари (відправник, подія), наприклад від компонента
+    void on(const string& sender, const string& event, Rules::Handler handler) {
+        mutableRules().on(sender, event, move(handler));
+    }
+
+    void notify(EventId sender, EventId event) override {
+        rules->dispatch(*this, sender, event);
+    }
+
+    // === Пакетний режим ===
+    // Еквівалентність визначено відносно негайної обробки: після commitBatch залежні
+    // компоненти в тому самому стані, що й після обробки тих самих подій по одній.
+    // Правила виконуються в порядку подій (вони залежать від історії: скасування
+    // самовивозу не повертає слоти), але кожне лише позначає в чернетці останнє
+    // джерело значення: явне значення або "за станом" дати чи чекбокса отримувача.
+    // "За станом" записує лише подія того самого компонента, тож останній такий
+    // запис бачив уже підсумковий стан — значення обчислюється один раз при фіксації,
+    // і компоненти змінюються лише там, де результат відрізняється від поточного.
+    void beginBatch() { ++batchDepth; }
+
+    void commitBatch() {
+        if (batchDepth == 0 || --batchDepth > 0)
+            return;
+        applyStaged();
+    }
+
+    bool inBatch() const { return batchDepth > 0; }
+    size_t getAppliedUpdates() const { return appliedUpdates; }
+
+    void notify(string sender, string event) override {
+        EventId s, e;
+        if (rules->findSender(sender, s) && rules->findEvent(event, e))
+            notify(s, e);
+    }
+};
+
+// === Пакет змін форми на час існування об'єкта ===
+class FormBatch {
+    OrderFormMediator& mediator;
+
+public:
+    explicit FormBatch(OrderFormMediator& m) : mediator(m) { mediator.beginBatch(); }
+    ~FormBatch() { mediator.commitBatch(); }
+    FormBatch(const FormBatch&) = delete;
+    FormBatch& operator=(const FormBatch&) = delete;
+};
+
+// === Пул об'єктів: сесії розміщуються в блоках, звільнені місця використовуються повторно ===
+template <typename T>
+class ObjectPool {
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t CHUNK = 4096;
+    vector<unique_ptr<Slot[]>> chunks;
+    vector<T*> freeList;
+    size_t used = 0; // зайнято місць в останньому блоці
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        void* place;
+        if (!freeList.empty()) {
+            place = freeList.back();
+            freeList.pop_back();
+        } else {
+            if (chunks.empty() || used == CHUNK) {
+                chunks.emplace_back(new Slot[CHUNK]);
+                used = 0;
+            }
+            place = chunks.back()[used++].storage;
+        }
+        return new (place) T(forward<Args>(args)...);
+    }
+
+    void destroy(T* object) {
+        object->~T();
+        freeList.push_back(object);
+    }
+};
+
+// === Сесія форми: шість компонентів і посередник в одному блоці пулу ===
+struct FormSession {
+    DeliveryDatePicker date;
+    TimeSlotSelector timeSlots;
+    OtherPersonCheckbox otherPerson;
+    RecipientNameField nameField;
+    RecipientPhoneField phoneField;
+    PickupCheckbox pickup;
+    OrderFormMediator mediator;
+    chrono::steady_clock::time_point lastActive;
+
+    FormSession(shared_ptr<const OrderFormMediator::Rules> rules, const SlotAvailabilityIndex* slotIndex)
+        : mediator(&date, &timeSlots, &otherPerson, &nameField, &phoneField, &pickup, move(rules)) {
+        mediator.setVerbose(false);
+        mediator.setSlotIndex(slotIndex);
+    }
+};
+
+// === Подія від клієнта ===
+enum class FormAction : uint8_t { SelectDate, ToggleOtherPerson, TogglePickup, Close };
+
+struct FormEvent {
+    uint64_t session;
+    FormAction action;
+    bool flag; // SelectDate: true — "Сьогодні"; Toggle*: новий стан
+};
+
+// Дія клієнта над компонентами сесії (Close обробляє шард)
+inline void applyAction(FormSession& s, FormAction action, bool flag) {
+    static const string today = "Сьогодні", tomorrow = "Завтра";
+    switch (action) {
+    case FormAction::SelectDate: s.date.selectDate(flag ? today : tomorrow); break;
+    case FormAction::ToggleOtherPerson: s.otherPerson.toggle(flag); break;
+    case FormAction::TogglePickup: s.pickup.toggle(flag); break;
+    case FormAction::Close: break;
+    }
+}
+
+// Стан залежних компонентів: слоти і видимість полів отримувача
+inline bool sameDependentState(const FormSession& a, const FormSession& b) {
+    if (a.timeSlots.getSlotCount() != b.timeSlots.getSlotCount())
+        return false;
+    for (size_t i = 0; i < a.timeSlots.getSlotCount(); ++i)
+        if (a.timeSlots.getSlot(i) != b.timeSlots.getSlot(i))
+            return false;
+    return a.nameField.isVisible() == b.nameField.isVisible() && a.phoneField.isVisible() == b.phoneField.isVisible();
+}
+
+// === Шард: власний потік, пул і таблиця сесій ===
+// Сесії шарду змінює лише його потік, тому самі сесії не потребують блокувань;
+// м'ютекс захищає тільки чергу вхідних подій.
+class FormShard {
+    shared_ptr<const OrderFormMediator::Rules> rules;
+    const SlotAvailabilityIndex* slotIndex;
+    chrono::milliseconds idleTimeout;
+    chrono::milliseconds sweepInterval; // не менше 1 мс, щоб нульовий тайм-аут не крутив цикл
+
+    ObjectPool<FormSession> pool;
+    unordered_map<uint64_t, FormSession*> sessions;
+    chrono::steady_clock::time_point lastSweep;
+
+    vector<FormEvent> inbox;
+    mutex mtx;
+    condition_variable wake, drained;
+    bool stopping = false;
+    bool busy = false;
+
+    atomic<size_t> live{0};
+    atomic<size_t> processed{0};
+    atomic<size_t> evicted{0};
+    thread worker;
+
+    // Події однієї пачки для кожної сесії обробляються як один пакет посередника;
+    // touched — сесії, для яких пакет відкрито
+    void apply(const FormEvent& event, chrono::steady_clock::time_point now, vector<uint64_t>& touched) {
+        auto it = sessions.find(event.session);
+        if (event.action == FormAction::Close) {
+            if (it != sessions.end()) {
+                it->second->mediator.commitBatch();
+                pool.destroy(it->second);
+                sessions.erase(it);
+                --live;
+            }
+            return;
+        }
+        if (it == sessions.end()) {
+            it = sessions.emplace(event.session, pool.create(rules, slotIndex)).first;
+            ++live;
+        }
+        FormSession& s = *it->second;
+        s.lastActive = now;
+        if (!s.mediator.inBatch()) {
+            s.mediator.beginBatch();
+            touched.push_back(event.session);
+        }
+        applyAction(s, event.action, event.flag);
+    }
+
+    // Вивантажує сесії, до яких клієнт не звертався довше за idleTimeout. Подія, що ще
+    // чекає в черзі, — теж звернення: під час черги в шарді її сесія не простоює.
+    // Викликається під mtx, щоб нові події не проскочили між перевіркою і вивантаженням.
+    void sweep(chrono::steady_clock::time_point now) {
+        lastSweep = now;
+        for (const FormEvent& event : inbox) {
+            auto it = sessions.find(event.session);
+            if (it != sessions.end())
+                it->second->lastActive = now;
+        }
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            if (now - it->second->lastActive >= idleTimeout) {
+                pool.destroy(it->second);
+                it = sessions.erase(it);
+                --live;
+                ++evicted;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void run() {
+        vector<FormEvent> batch;
+        vector<uint64_t> touched;
+        unique_lock<mutex> lock(mtx);
+        while (!stopping) {
+            wake.wait_for(lock, sweepInterval, [&] { return stopping || !inbox.empty(); });
+            batch.swap(inbox);
+            busy = true;
+            lock.unlock();
+
+            auto now = chrono::steady_clock::now();
+            for (const FormEvent& event : batch)
+                apply(event, now, touched);
+            for (uint64_t id : touched) {
+                auto it = sessions.find(id);
+                if (it != sessions.end())
+                    it->second->mediator.commitBatch();
+            }
+            touched.clear();
+            processed += batch.size();
+            batch.clear();
+
+            lock.lock();
+            if (now - lastSweep >= sweepInterval)
+                sweep(now);
+            busy = false;
+            if (inbox.empty())
+                drained.notify_all();
+        }
+    }
+
+public:
+    FormShard(shared_ptr<const OrderFormMediator::Rules> r, const SlotAvailabilityIndex* index,
+              chrono::milliseconds timeout)
+        : rules(move(r)), slotIndex(index), idleTimeout(timeout),
+          sweepInterval(max(timeout / 2, chrono::milliseconds(1))), lastSweep(chrono::steady_clock::now()),
+          worker(&FormShard::run, this) {}
+
+    ~FormShard() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+        for (auto& entry : sessions)
+            pool.destroy(entry.second);
+    }
+
+    void post(const FormEvent* events, size_t count) {
+        {
+            lock_guard<mutex> lock(mtx);
+            inbox.insert(inbox.end(), events, events + count);
+        }
+        wake.notify_one();
+    }
+
+    // Чекає, поки шард обробить усі надіслані події
+    void drain() {
+        unique_lock<mutex> lock(mtx);
+        drained.wait(lock, [&] { return inbox.empty() && !busy; });
+    }
+
+    size_t sessionCount() const { return live; }
+    size_t processedEvents() const { return processed; }
+    size_t evictedSessions() const { return evicted; }
+};
+
+// === Рушій форм: сесії розподіляються між шардами за ідентифікатором ===
+class FormEngine {
+    vector<unique_ptr<FormShard>> shards;
+
+public:
+    FormEngine(size_t shardCount, chrono::milliseconds idleTimeout,
+               const SlotAvailabilityIndex* slotIndex = nullptr,
+               shared_ptr<const OrderFormMediator::Rules> rules = OrderFormMediator::defaultRules()) {
+        shardCount = max<size_t>(shardCount, 1);
+        for (size_t i = 0; i < shardCount; ++i)
+            shards.push_back(make_unique<FormShard>(rules, slotIndex, idleTimeout));
+    }
+
+    size_t shardCount() const { return shards.size(); }
+
+    // Події групуються за шардами: одне блокування черги на шард за пакет
+    void submit(const vector<FormEvent>& events) {
+        vector<vector<FormEvent>> routed(shards.size());
+        for (const FormEvent& event : events)
+            routed[event.session % shards.size()].push_back(event);
+        for (size_t i = 0; i < shards.size(); ++i)
+            if (!routed[i].empty())
+                shards[i]->post(routed[i].data(), routed[i].size());
+    }
+
+    void drain() {
+        for (auto& shard : shards)
+            shard->drain();
+    }
+
+    size_t sessionCount() const {
+        size_t total = 0;
+        for (auto& shard : shards) total += shard->sessionCount();
+        return total;
+    }
+
+    size_t processedEvents() const {
+        size_t total = 0;
+        for (auto& shard : shards) total += shard->processedEvents();
+        return total;
+    }
+
+    size_t evictedSessions() const {
+        size_t total = 0;
+        for (auto& shard : shards) total += shard->evictedSessions();
+        return total;
+    }
+};
+
+// === Клієнтський код ===
+int main() {
+#ifdef _WIN32
+    SetConsoleOutputCP(65001);
+#endif
+
+    // Створюємо елементи форми
+    DeliveryDatePicker date;
+    TimeSlotSelector timeSlots;
+    OtherPersonCheckbox otherPerson;
+    RecipientNameField nameField;
+    RecipientPhoneField phoneField;
+    PickupCheckbox pickup;
+
+    // Створюємо посередника
+    OrderFormMediator mediator(&date, &timeSlots, &otherPerson, &nameField, &phoneField, &pickup);
+
+    cout << "\n=== Демонстрація роботи патерну Посередник ===\n\n";
+
+    // 1. Користувач обирає дату доставки
+    date.selectDate("Сьогодні");
+
+    // 2. Користувач вказує, що отримувач інша особа
+    otherPerson.toggle(true);
+
+    // 3. Користувач передумав — сам забере квіти
+    pickup.toggle(true);
+
+    // 4. Потім знову передумав — хоче доставку
+    pickup.toggle(false);
+
+    // Пакетний режим: сплеск змін обробляється один раз, застосовуються лише підсумкові зміни
+    cout << "\n=== Пакетний режим ===\n";
+    {
+        FormBatch batch(mediator);
+        pickup.toggle(true);
+        pickup.toggle(false);
+        otherPerson.toggle(false);
+        otherPerson.toggle(true);
+        date.selectDate("Завтра");
+        cout << "--- фіксація пакета ---\n";
+    }
+
+    // Рядковий API залишився для сумісності
+    cout << "\n=== Рядковий API ===\n";
+    mediator.notify("OtherPersonCheckbox", "Toggled");
+
+    // Швидкість диспетчеризації: інтерновані id проти рядкового API
+    cout << "\n=== Диспетчеризація подій ===\n";
+    mediator.setVerbose(false);
+    const size_t events = 1000000;
+    EventId sender = mediator.senderId("OtherPersonCheckbox"), toggled = mediator.eventId("Toggled");
+
+    size_t allocsBefore = alloc_counter::allocationCount();
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < events; ++i)
+        mediator.notify(sender, toggled);
+    double idSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t idAllocs = alloc_counter::allocationCount() - allocsBefore;
+
+    allocsBefore = alloc_counter::allocationCount();
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < events; ++i)
+        mediator.notify(string("OtherPersonCheckbox"), string("Toggled"));
+    double stringSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t stringAllocs = alloc_counter::allocationCount() - allocsBefore;
+
+    cout << "За id:     " << events / idSeconds / 1e6 << " млн подій/с, виділень: " << idAllocs << "\n";
+    cout << "За рядком: " << events / stringSeconds / 1e6 << " млн подій/с, виділень: " << stringAllocs << "\n";
+
+    const string today = "Сьогодні", tomorrow = "Завтра";
+    allocsBefore = alloc_counter::allocationCount();
+    for (size_t i = 0; i < events; ++i) {
+        date.selectDate(i % 2 ? today : tomorrow);
+        pickup.toggle(i % 3 == 0);
+    }
+    cout << "Зміна дати і самовивозу, виділень на " << 2 * events << " подій: "
+         << alloc_counter::allocationCount() - allocsBefore << "\n";
+
+    // Робота на один сплеск подій: негайно проти пакета
+    const size_t bursts = 200000;
+    auto burst = [&](size_t i) {
+        date.selectDate(i % 2 ? today : tomorrow);
+        otherPerson.toggle(true);
+        pickup.toggle(true);
+        pickup.toggle(false);
+        otherPerson.toggle(i % 3 != 0);
+    };
+    size_t updatesBefore = mediator.getAppliedUpdates();
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < bursts; ++i)
+        burst(i);
+    double immediateSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t immediateUpdates = mediator.getAppliedUpdates() - updatesBefore;
+
+    updatesBefore = mediator.getAppliedUpdates();
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < bursts; ++i) {
+        FormBatch batch(mediator);
+        burst(i);
+    }
+    double batchSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t batchUpdates = mediator.getAppliedUpdates() - updatesBefore;
+    cout << "Сплеск із 5 подій, негайно:  " << double(immediateUpdates) / bursts << " змін компонентів, "
+         << immediateSeconds * 1e9 / bursts << " нс\n";
+    cout << "Сплеск із 5 подій, пакетом: " << double(batchUpdates) / bursts << " змін компонентів, "
+         << batchSeconds * 1e9 / bursts << " нс\n";
+
+    // Пакет і негайна обробка тих самих подій дають однаковий стан залежних компонентів
+    {
+        auto rules = OrderFormMediator::defaultRules();
+        auto sameAfter = [&](FormSession& immediate, FormSession& batched,
+                             const vector<pair<FormAction, bool>>& actions) {
+            for (auto& a : actions)
+                applyAction(immediate, a.first, a.second);
+            {
+                batched.mediator.beginBatch();
+                for (auto& a : actions)
+                    applyAction(batched, a.first, a.second);
+                batched.mediator.commitBatch();
+            }
+            return sameDependentState(immediate, batched);
+        };
+        const pair<const char*, vector<pair<FormAction, bool>>> cases[] = {
+            {"самовивіз, потім інша особа",
+             {{FormAction::TogglePickup, true}, {FormAction::ToggleOtherPerson, true}}},
+            {"дата, самовивіз увімк., самовивіз вимк.",
+             {{FormAction::SelectDate, true}, {FormAction::TogglePickup, true}, {FormAction::TogglePickup, false}}}};
+        // Правила негайного режиму — як у вихідній формі: самовивіз не блокує пізніший
+        // показ полів отримувача, а його скасування не повертає прибрані слоти
+        for (auto& c : cases) {
+            FormSession immediate(rules, nullptr), batched(rules, nullptr);
+            bool same = sameAfter(immediate, batched, c.second);
+            cout << "Пакет == негайно (" << c.first << "): " << (same ? "так" : "НІ") << " — слотів "
+                 << batched.timeSlots.getSlotCount() << ", поля отримувача "
+                 << (batched.nameField.isVisible() ? "показано" : "сховано") << "\n";
+        }
+
+        FormSession immediate(rules, nullptr), batched(rules, nullptr);
+        uint64_t seed = 2463534242ull;
+        size_t mismatches = 0;
+        vector<pair<FormAction, bool>> actions;
+        const size_t randomBursts = 10000;
+        for (size_t i = 0; i < randomBursts; ++i) {
+            actions.clear();
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            for (size_t k = 0, n = 1 + seed % 6; k < n; ++k)
+                actions.push_back({FormAction((seed >> (8 + 3 * k)) % 3), (seed >> (40 + k) & 1) != 0});
+            mismatches += !sameAfter(immediate, batched, actions);
+        }
+        cout << "Випадкові сплески (" << randomBursts << "): розбіжностей " << mismatches << "\n";
+    }
+
+    // Індекс доступності: слоти з урахуванням місткості кур'єрів
+    cout << "\n=== Індекс доступності слотів ===\n";
+    SlotAvailabilityIndex slotIndex;
+    size_t todayIndex = slotIndex.addDate("Сьогодні", {{"12:00", 2}, {"14:00", 1}, {"16:00", 3}});
+    slotIndex.addDate("Завтра", {{"10:00", 5}, {"12:00", 5}, {"15:00", 5}, {"18:00", 5}});
+    mediator.setSlotIndex(&slotIndex);
+    mediator.setVerbose(true);
+    date.selectDate(today);
+    cout << "Бронюємо 14:00: " << (slotIndex.reserve(todayIndex, 1) ? "так" : "ні")
+         << ", ще раз: " << (slotIndex.reserve(todayIndex, 1) ? "так" : "ні") << "\n";
+    date.selectDate(today);
+    slotIndex.release(todayIndex, 1);
+    mediator.setVerbose(false);
+
+    allocsBefore = alloc_counter::allocationCount();
+    for (size_t i = 0; i < events; ++i)
+        date.selectDate(i % 2 ? today : tomorrow);
+    cout << "Запити доступності на зміну дати, виділень на " << events << " подій: "
+         << alloc_counter::allocationCount() - allocsBefore << "\n";
+
+    // Одночасні бронювання: місткість не перевищується
+    {
+        const size_t slotsPerDay = 8, capacityPerSlot = 50000;
+        SlotAvailabilityIndex busyIndex;
+        vector<SlotAvailabilityIndex::SlotCapacity> busySlots;
+        for (size_t i = 0; i < slotsPerDay; ++i)
+            busySlots.push_back({to_string(9 + i) + ":00", (int)capacityPerSlot});
+        size_t day = busyIndex.addDate("Пікова дата", busySlots);
+        busySlots.push_back({"20:00", 1});
+        try {
+            busyIndex.addDate("Переповнена дата", busySlots);
+        } catch (const length_error& e) {
+            cout << "Відхилено: " << e.what() << "\n";
+        }
+
+        size_t threadCount = max<size_t>(thread::hardware_concurrency(), 4);
+        const size_t attemptsPerThread = slotsPerDay * capacityPerSlot * 2 / threadCount;
+        atomic<size_t> reserved{0};
+        vector<thread> customers;
+        start = chrono::steady_clock::now();
+        for (size_t t = 0; t < threadCount; ++t)
+            customers.emplace_back([&, t] {
+                size_t mine = 0;
+                uint64_t seed = 0x9E3779B97F4A7C15ull * (t + 1);
+                for (size_t i = 0; i < attemptsPerThread; ++i) {
+                    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+                    size_t slot = seed % slotsPerDay;
+                    if (busyIndex.reserve(day, slot)) {
+                        ++mine;
+                        if (seed >> 60 == 0 && busyIndex.release(day, slot)) // зрідка скасування
+                            --mine;
+                    }
+                }
+                reserved += mine;
+            });
+        for (auto& c : customers)
+            c.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        size_t left = 0;
+        bool negative = false;
+        for (size_t i = 0; i < slotsPerDay; ++i) {
+            left += busyIndex.remaining(day, i);
+            negative |= busyIndex.remaining(day, i) < 0;
+        }
+        cout << "Потоків: " << threadCount << " | " << threadCount * attemptsPerThread / seconds / 1e6
+             << " млн спроб/с | заброньовано " << reserved << " + вільно " << left << " = "
+             << reserved + left << " з " << slotsPerDay * capacityPerSlot
+             << (negative || reserved + left != slotsPerDay * capacityPerSlot ? " — ПОМИЛКА" : " — без перебронювань")
+             << "\n";
+    }
+
+    // Багато форм в одному процесі: шарди, пул сесій, вивантаження неактивних
+    cout << "\n=== Рушій форм: 200000 сесій ===\n";
+    const size_t sessionTotal = 200000, eventTotal = 4000000, batchSize = 10000;
+    const chrono::milliseconds idleTimeout(1000);
+    {
+        FormEngine engine(max<size_t>(thread::hardware_concurrency(), 2), idleTimeout, &slotIndex);
+        vector<FormEvent> batch;
+
+        size_t bytesBefore = alloc_counter::liveBytes();
+        for (uint64_t s = 0; s < sessionTotal; ++s) {
+            batch.push_back({s, FormAction::SelectDate, s % 2 == 0});
+            if (batch.size() == batchSize || s + 1 == sessionTotal) {
+                engine.submit(batch);
+                batch.clear();
+            }
+        }
+        engine.drain();
+        double bytesPerSession = double(alloc_counter::liveBytes() - bytesBefore) / engine.sessionCount();
+
+        uint64_t seed = 88172645463325252ull;
+        size_t processedBefore = engine.processedEvents();
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < eventTotal; ++i) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            batch.push_back({seed % sessionTotal, FormAction((seed >> 32) % 3), (seed >> 40 & 1) != 0});
+            if (batch.size() == batchSize) {
+                engine.submit(batch);
+                batch.clear();
+            }
+        }
+        engine.submit(batch);
+        batch.clear();
+        engine.drain();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        size_t processedEvents = engine.processedEvents() - processedBefore;
+
+        cout << "Шардів: " << engine.shardCount() << " | подій: " << processedEvents << " | "
+             << processedEvents / seconds / 1e6 << " млн подій/с\n";
+        cout << "Пам'ять на сесію: " << bytesPerSession << " байт (sizeof(FormSession) = "
+             << sizeof(FormSession) << ")\n";
+
+        size_t activeBefore = engine.sessionCount();
+        // Під час навантаження вивантажуються лише сесії, чия остання подія вже оброблена
+        // понад idleTimeout тому і для яких у черзі немає нових подій
+        cout << "Вивантажено під час навантаження (без подій понад " << idleTimeout.count()
+             << " мс): " << engine.evictedSessions() << "\n";
+        this_thread::sleep_for(idleTimeout * 2);
+        cout << "Активних сесій: " << activeBefore << " -> " << engine.sessionCount()
+             << " після " << (idleTimeout * 2).count() << " мс простою (вивантажено "
+             << engine.evictedSessions() << ")\n";
+    }
+
+    return 0;
+}
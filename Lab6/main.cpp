@@ -1,89 +1,409 @@
-#include <iostream>
-#include <string>
-#include <map>
-#include <windows.h>
-using namespace std;
-
-// Інтерфейс завантажувача
-class Downloader {
-public:
-    virtual string download(const string& url) = 0;
-    virtual ~Downloader() {}
-};
-
-// Реальна реалізація завантажувача
-class SimpleDownloader : public Downloader {
-public:
-    string download(const string& url) override {
-
-        cout << "[SimpleDownloader] Завантаження файлу з: " << url << endl;
-        // Повертаємо "завантажені дані" у вигляді рядка
-        return "Дані_файлу_з_" + url;
-    }
-};
-
-// Проксі з кешуванням
-class CachedDownloader : public Downloader {
-private:
-    Downloader* realDownloader;
-    map<string, string> cache;
-
-public:
-    // Проксі приймає вказівник на реальний завантажувач
-    CachedDownloader(Downloader* downloader)
-        : realDownloader(downloader) {}
-
-    ~CachedDownloader() {
-    }
-
-    string download(const string& url) override {
-        auto it = cache.find(url);
-        if (it != cache.end()) {
-            cout << "[Proxy] Отримано з кешу: " << url << endl;
-            return it->second;
-        }
-
-        cout << "[Proxy] Кеш відсутній. Завантажуємо: " << url << endl;
-        string data = realDownloader->download(url);
-        cache[url] = data;
-        return data;
-    }
-
-    void clearCache() {
-        cache.clear();
-    }
-
-    bool hasInCache(const string& url) const {
-        return cache.find(url) != cache.end();
-    }
-};
-
-// Демонстрація використання
-int main() {
-    SetConsoleOutputCP(65001);
-    // Створимо реальний завантажувач
-    SimpleDownloader* real = new SimpleDownloader();
-
-    // Створимо проксі, який використовуватиме реальний завантажувач
-    CachedDownloader* proxy = new CachedDownloader(real);
-
-    cout << "=== Виклик напряму через SimpleDownloader ===" << endl;
-    string r1 = real->download("http://example.com/file1.txt");
-
-    cout << "\n=== Виклики через CachedDownloader (Proxy) ===" << endl;
-    string p1 = proxy->download("http://example.com/file1.txt"); // завантажить і збереже в кеш
-    string p2 = proxy->download("http://example.com/file1.txt"); // візьме з кешу
-    string p3 = proxy->download("http://example.com/file2.txt"); // завантажить інший файл
-
-    cout << "\n=== Результати (плохоформатований вивід даних) ===" << endl;
-    cout << "real: " << r1 << endl;
-    cout << "proxy p1: " << p1 << endl;
-    cout << "proxy p2: " << p2 << endl;
-    cout << "proxy p3: " << p3 << endl;
-
-    // Очищення пам'яті
-    delete proxy;
-    delete real;
-
-    return 0;
-}
+#include <iostream>
+#include <string>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "../common/telemetry.h"
+
+using namespace std;
+
+// Інтерфейс завантажувача
+class Downloader {
+public:
+    virtual string download(const string& url) = 0;
+    virtual ~Downloader() {}
+};
+
+// Реальна реалізація завантажувача
+class SimpleDownloader : public Downloader {
+public:
+    string download(const string& url) override {
+
+        TLOG(Info) << "[SimpleDownloader] Завантаження файлу з: " << url << endl;
+        // Повертаємо "завантажені дані" у вигляді рядка
+        return "Дані_файлу_з_" + url;
+    }
+};
+
+// Джерело, яке підтримує запити діапазонів байтів (аналог HTTP HEAD + Range)
+class RangeSource {
+public:
+    // Розмір об'єкта в байтах (HEAD-запит); false — об'єкта немає (404)
+    virtual bool probeSize(const string& url, size_t& size) = 0;
+    // Завантажує [offset, offset + length) у out; false — якщо запит не вдався
+    virtual bool fetchRange(const string& url, size_t offset, size_t length, char* out) = 0;
+    virtual ~RangeSource() {}
+};
+
+// Імітація HTTP-сервера: віддає вміст файлів частинами.
+// Кожен запит чекає затримку мережі і передає дані з обмеженою швидкістю одного
+// з'єднання, тож виграш від паралельних діапазонів вимірюється, а не лише memcpy.
+class SimulatedRangeServer : public RangeSource {
+private:
+    map<string, string> files;
+    int failEvery;                 // кожен failEvery-й запит завершується помилкою (0 — без помилок)
+    chrono::microseconds latency;  // затримка відповіді на кожен запит
+    double bytesPerSecond;         // швидкість одного з'єднання (0 — без обмеження)
+    atomic<int> requestCounter{0};
+
+    void simulateTransfer(size_t length) const {
+        auto delay = latency;
+        if (bytesPerSecond > 0)
+            delay += chrono::microseconds((long long)(length / bytesPerSecond * 1e6));
+        if (delay.count() > 0)
+            this_thread::sleep_for(delay);
+    }
+
+public:
+    SimulatedRangeServer(int failEvery = 0, chrono::microseconds latency = chrono::microseconds(0),
+                         double bytesPerSecond = 0)
+        : failEvery(failEvery), latency(latency), bytesPerSecond(bytesPerSecond) {}
+
+    void addFile(const string& url, const string& content) {
+        files[url] = content;
+    }
+
+    bool probeSize(const string& url, size_t& size) override {
+        simulateTransfer(0);
+        auto it = files.find(url);
+        if (it == files.end())
+            return false;
+        size = it->second.size();
+        return true;
+    }
+
+    bool fetchRange(const string& url, size_t offset, size_t length, char* out) override {
+        int n = ++requestCounter;
+        simulateTransfer(length);
+        if (failEvery > 0 && n % failEvery == 0)
+            return false;
+
+        auto it = files.find(url);
+        if (it == files.end() || offset + length > it->second.size())
+            return false;
+        memcpy(out, it->second.data() + offset, length);
+        return true;
+    }
+};
+
+// З'єднання з сервером (повторно використовується між завантаженнями)
+class Connection {
+private:
+    RangeSource* source;
+    int id;
+
+public:
+    Connection(RangeSource* s, int id) : source(s), id(id) {}
+
+    int getId() const { return id; }
+
+    bool get(const string& url, size_t offset, size_t length, char* out) {
+        return source->fetchRange(url, offset, length, out);
+    }
+};
+
+// Пул з'єднань: з'єднання створюються ліниво і повертаються в пул після використання
+class ConnectionPool {
+private:
+    RangeSource* source;
+    vector<unique_ptr<Connection>> all;
+    vector<Connection*> idle;
+    int opened = 0;
+    mutex mtx;
+
+public:
+    ConnectionPool(RangeSource* s) : source(s) {}
+
+    Connection* acquire() {
+        lock_guard<mutex> lock(mtx);
+        if (!idle.empty()) {
+            Connection* c = idle.back();
+            idle.pop_back();
+            return c;
+        }
+        all.push_back(make_unique<Connection>(source, opened++));
+        return all.back().get();
+    }
+
+    void release(Connection* c) {
+        lock_guard<mutex> lock(mtx);
+        idle.push_back(c);
+    }
+
+    // Закриває з'єднання після помилки: наступний acquire відкриє нове
+    void discard(Connection* c) {
+        lock_guard<mutex> lock(mtx);
+        all.erase(remove_if(all.begin(), all.end(),
+                            [c](const unique_ptr<Connection>& p) { return p.get() == c; }),
+                  all.end());
+    }
+
+    size_t size() {
+        lock_guard<mutex> lock(mtx);
+        return all.size();
+    }
+
+    // Скільки з'єднань відкрито за весь час, включно із закритими після помилок
+    int openedCount() {
+        lock_guard<mutex> lock(mtx);
+        return opened;
+    }
+};
+
+// Паралельний завантажувач: ділить файл на діапазони і завантажує їх одночасно
+class ParallelChunkDownloader : public Downloader {
+private:
+    RangeSource* source;
+    ConnectionPool pool;
+    size_t chunkCount;
+    size_t threadCount;
+    int maxRetries;
+    chrono::milliseconds retryDelay;   // пауза перед першим повтором, далі подвоюється
+    static constexpr chrono::milliseconds MAX_RETRY_DELAY{200};
+
+    struct Chunk {
+        size_t offset;
+        size_t length;
+    };
+
+    // Завантаження одного діапазону з повторними спробами. Після помилки з'єднання
+    // закривається, а повтор іде новим з'єднанням після експоненційної паузи.
+    // Після останньої невдалої спроби нове з'єднання не відкривається: conn == nullptr.
+    bool fetchChunk(Connection*& conn, const string& url, const Chunk& chunk, char* buffer) {
+        static const telemetry::Counter retries("downloader.chunk_retry");
+        chrono::milliseconds delay = retryDelay;
+        for (int attempt = 0; ; ++attempt) {
+            if (conn->get(url, chunk.offset, chunk.length, buffer + chunk.offset))
+                return true;
+            pool.discard(conn);
+            if (attempt == maxRetries) {
+                conn = nullptr;
+                break;
+            }
+            conn = pool.acquire();
+            retries.add();
+            this_thread::sleep_for(delay);
+            delay = min(delay * 2, MAX_RETRY_DELAY);
+        }
+        TLOG(Error) << "[ParallelChunkDownloader] Діапазон " << chunk.offset << "+" << chunk.length
+                    << " не завантажено після " << maxRetries << " повторів\n";
+        return false;
+    }
+
+public:
+    ParallelChunkDownloader(RangeSource* s, size_t chunks = 8, size_t threads = 4, int retries = 3,
+                            chrono::milliseconds retryDelay = chrono::milliseconds(1))
+        : source(s), pool(s),
+          chunkCount(max<size_t>(chunks, 1)),
+          threadCount(max<size_t>(threads, 1)),
+          maxRetries(retries),
+          retryDelay(retryDelay) {}
+
+    void setChunkCount(size_t chunks) { chunkCount = max<size_t>(chunks, 1); }
+
+    int openedConnections() { return pool.openedCount(); }
+
+    string download(const string& url) override {
+        size_t size = 0;
+        if (!source->probeSize(url, size))
+            throw runtime_error("Файл не знайдено: " + url);
+        TLOG(Info) << "[ParallelChunkDownloader] Завантаження файлу з: " << url
+                   << " (" << size << " байт)" << endl;
+
+        // Розбиваємо об'єкт на діапазони приблизно однакового розміру
+        vector<Chunk> chunks;
+        size_t count = min(chunkCount, max<size_t>(size, 1));
+        size_t base = size / count, extra = size % count, offset = 0;
+        for (size_t i = 0; i < count; ++i) {
+            size_t length = base + (i < extra ? 1 : 0);
+            chunks.push_back({offset, length});
+            offset += length;
+        }
+
+        // Попередньо виділений буфер — кожен діапазон пишеться у своє місце
+        string result(size, '\0');
+        atomic<size_t> next{0};
+        atomic<bool> failed{false};
+
+        static const telemetry::Histogram chunkLatency("downloader.chunk_ns");
+        auto worker = [&]() {
+            Connection* conn = pool.acquire();
+            for (size_t i = next++; i < chunks.size() && !failed; i = next++) {
+                telemetry::Span span(chunkLatency);
+                if (!fetchChunk(conn, url, chunks[i], &result[0]))
+                    failed = true;
+            }
+            if (conn)
+                pool.release(conn);
+        };
+
+        vector<thread> workers;
+        size_t n = min(threadCount, chunks.size());
+        for (size_t i = 0; i < n; ++i)
+            workers.emplace_back(worker);
+        for (auto& t : workers)
+            t.join();
+
+        if (failed)
+            throw runtime_error("Не вдалося завантажити файл: " + url);
+        return result;
+    }
+};
+
+// Проксі з кешуванням
+class CachedDownloader : public Downloader {
+private:
+    Downloader* realDownloader;
+    map<string, string> cache;
+
+public:
+    // Проксі приймає вказівник на реальний завантажувач
+    CachedDownloader(Downloader* downloader)
+        : realDownloader(downloader) {}
+
+    ~CachedDownloader() {
+    }
+
+    string download(const string& url) override {
+        static const telemetry::Counter hits("downloader.cache_hit");
+        static const telemetry::Counter misses("downloader.cache_miss");
+        static const telemetry::Histogram fetchLatency("downloader.fetch_ns");
+        auto it = cache.find(url);
+        if (it != cache.end()) {
+            hits.add();
+            TLOG(Debug) << "[Proxy] Отримано з кешу: " << url << endl;
+            return it->second;
+        }
+
+        misses.add();
+        TLOG(Info) << "[Proxy] Кеш відсутній. Завантажуємо: " << url << endl;
+        string data;
+        {
+            telemetry::Span span(fetchLatency);
+            data = realDownloader->download(url);
+        }
+        cache[url] = data;
+        return data;
+    }
+
+    void clearCache() {
+        cache.clear();
+    }
+
+    bool hasInCache(const string& url) const {
+        return cache.find(url) != cache.end();
+    }
+};
+
+// Демонстрація використання
+int main() {
+#ifdef _WIN32
+    SetConsoleOutputCP(65001);
+#endif
+    // Створимо реальний завантажувач
+    SimpleDownloader* real = new SimpleDownloader();
+
+    // Створимо проксі, який використовуватиме реальний завантажувач
+    CachedDownloader* proxy = new CachedDownloader(real);
+
+    cout << "=== Виклик напряму через SimpleDownloader ===" << endl;
+    string r1 = real->download("http://example.com/file1.txt");
+
+    // Журнал виводиться у фоні — вивантажуємо його перед кожним прямим виводом
+    telemetry::flush();
+    cout << "\n=== Виклики через CachedDownloader (Proxy) ===" << endl;
+    string p1 = proxy->download("http://example.com/file1.txt"); // завантажить і збереже в кеш
+    string p2 = proxy->download("http://example.com/file1.txt"); // візьме з кешу
+    string p3 = proxy->download("http://example.com/file2.txt"); // завантажить інший файл
+
+    telemetry::flush();
+    cout << "\n=== Результати (плохоформатований вивід даних) ===" << endl;
+    cout << "real: " << r1 << endl;
+    cout << "proxy p1: " << p1 << endl;
+    cout << "proxy p2: " << p2 << endl;
+    cout << "proxy p3: " << p3 << endl;
+
+    cout << "\n=== Паралельне завантаження частинами через CachedDownloader ===" << endl;
+    // Кожен 5-й запит до сервера завершується помилкою — діапазони завантажуються повторно
+    SimulatedRangeServer* server = new SimulatedRangeServer(5);
+    server->addFile("http://example.com/file1.txt", "Дані_файлу_з_http://example.com/file1.txt");
+    ParallelChunkDownloader* chunked = new ParallelChunkDownloader(server, 16, 4);
+    CachedDownloader* chunkedProxy = new CachedDownloader(chunked);
+
+    string c1 = chunkedProxy->download("http://example.com/file1.txt");
+    string c2 = chunkedProxy->download("http://example.com/file1.txt"); // візьме з кешу
+    telemetry::flush();
+    cout << "chunked c1: " << c1 << endl;
+    cout << "Збігається з SimpleDownloader: " << (c1 == r1 ? "так" : "ні") << endl;
+    // Кожен повтор іде новим з'єднанням
+    cout << "Відкрито з'єднань (з повторами): " << chunked->openedConnections() << endl;
+    try {
+        chunkedProxy->download("http://example.com/missing.txt");
+        cout << "missing.txt завантажено — помилка" << endl;
+    } catch (const runtime_error& e) {
+        telemetry::flush();
+        cout << "missing.txt: " << e.what() << endl;
+    }
+    // Сервер, що відмовляє завжди: нові з'єднання відкриваються лише для повторів
+    SimulatedRangeServer* broken = new SimulatedRangeServer(1);
+    broken->addFile("http://example.com/file1.txt", "Дані_файлу_з_http://example.com/file1.txt");
+    ParallelChunkDownloader* failing = new ParallelChunkDownloader(broken, 1, 1, 2);
+    try {
+        failing->download("http://example.com/file1.txt");
+    } catch (const runtime_error&) {
+    }
+    telemetry::flush();
+    cout << "Відмова після 2 повторів: відкрито з'єднань " << failing->openedConnections()
+         << " (перша спроба + 2 повтори)" << endl;
+
+    cout << "\n=== Пропускна здатність залежно від кількості частин ===" << endl;
+    // Сервер: 5 мс на запит і 64 МБ/с на з'єднання; 8 потоків завантаження.
+    // Малі частини впираються у швидкість одного з'єднання, дуже дрібні — у затримку запитів.
+    // Діапазони кожного потоку записуються у трасу (chrome://tracing, Perfetto)
+    const string tracePath = (filesystem::temp_directory_path() / "lab6_download_trace.json").string();
+    bool tracing = telemetry::Telemetry::instance().startTrace(tracePath);
+    SimulatedRangeServer* reliable = new SimulatedRangeServer(0, chrono::milliseconds(5), 64.0 * 1024 * 1024);
+    reliable->addFile("http://example.com/big.bin", string(16 * 1024 * 1024, 'x'));
+    ParallelChunkDownloader* bench = new ParallelChunkDownloader(reliable, 1, 8);
+    for (size_t chunks : {1, 2, 4, 8, 16, 64}) {
+        bench->setChunkCount(chunks);
+        auto start = chrono::steady_clock::now();
+        string data = bench->download("http://example.com/big.bin");
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        telemetry::flush();
+        cout << "частин: " << chunks << " | " << (data.size() / (1024.0 * 1024.0)) / seconds << " МБ/с" << endl;
+    }
+    if (tracing) {
+        telemetry::Telemetry::instance().stopTrace();
+        cout << "Трасу збережено в " << tracePath << " (видаляється після завершення)" << endl;
+    }
+
+    // Очищення пам'яті
+    delete proxy;
+    delete real;
+    delete chunkedProxy;
+    delete chunked;
+    delete server;
+    delete failing;
+    delete broken;
+    delete bench;
+    delete reliable;
+    error_code ignored;
+    filesystem::remove(tracePath, ignored);
+
+    telemetry::Telemetry::instance().report(cout);
+
+    return 0;
+}
@@ -1,100 +1,1077 @@
-#include <iostream>
-#include <string>
-#include <windows.h>
-using namespace std;
-
-// ===== Інтерфейс Стратегії =====
-class DeliveryStrategy {
-public:
-    virtual double calculateCost(double distance, double weight) = 0;
-    virtual string getName() = 0;
-    virtual ~DeliveryStrategy() {}
-};
-
-// ===== Конкретна стратегія 1: Самовивіз =====
-class SelfPickupStrategy : public DeliveryStrategy {
-public:
-    double calculateCost(double distance, double weight) override {
-        // Самовивіз — безкоштовна доставка
-        return 0.0;
-    }
-    string getName() override {
-        return "Самовивіз";
-    }
-};
-
-// ===== Конкретна стратегія 2: Зовнішня служба =====
-class ExternalDeliveryStrategy : public DeliveryStrategy {
-public:
-    double calculateCost(double distance, double weight) override {
-        // Формула може бути складною, але ми просто імітуємо:
-        return 5.0 + distance * 0.5 + weight * 0.2;
-    }
-    string getName() override {
-        return "Зовнішня служба доставки";
-    }
-};
-
-// ===== Конкретна стратегія 3: Власна служба =====
-class InternalDeliveryStrategy : public DeliveryStrategy {
-public:
-    double calculateCost(double distance, double weight) override {
-        // Власна служба може мати знижки або іншу логіку
-        return 3.0 + distance * 0.3 + weight * 0.1;
-    }
-    string getName() override {
-        return "Власна служба доставки";
-    }
-};
-
-// ===== Контекст, який використовує стратегію =====
-class DeliveryContext {
-private:
-    DeliveryStrategy* strategy;  // поточна стратегія доставки
-public:
-    DeliveryContext(DeliveryStrategy* s = nullptr)
-        : strategy(s) {}
-
-    void setStrategy(DeliveryStrategy* s) {
-        strategy = s;
-    }
-
-    void calculate(double distance, double weight) {
-        if (!strategy) {
-            cout << "❌ Стратегію не вибрано!\n";
-            return;
-        }
-        double cost = strategy->calculateCost(distance, weight);
-        cout << "Обрана стратегія: " << strategy->getName() << endl;
-        cout << "Відстань: " << distance << " км, Вага: " << weight << " кг" << endl;
-        cout << "Вартість доставки: " << cost << " грн\n\n";
-    }
-};
-
-// ===== Клієнтський код =====
-int main() {
-    SetConsoleOutputCP(65001);
-    // Стратегії
-    SelfPickupStrategy selfPickup;
-    ExternalDeliveryStrategy externalDelivery;
-    InternalDeliveryStrategy internalDelivery;
-
-    // Контекст
-    DeliveryContext context;
-
-    cout << "=== Розрахунок вартості доставки ===\n\n";
-
-    // 1️Самовивіз
-    context.setStrategy(&selfPickup);
-    context.calculate(10, 5);
-
-    // 2️Зовнішня служба
-    context.setStrategy(&externalDelivery);
-    context.calculate(10, 5);
-
-    // 3️Власна служба
-    context.setStrategy(&internalDelivery);
-    context.calculate(10, 5);
-
-    return 0;
-}
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DELIVERY_USE_SSE2
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "../common/telemetry.h"
+
+using namespace std;
+
+// ===== Інтерфейс Стратегії =====
+class DeliveryStrategy {
+public:
+    virtual double calculateCost(double distance, double weight) = 0;
+    virtual string getName() = 0;
+    // Чи це самовивіз (клієнт забирає замовлення сам)
+    virtual bool isPickup() const { return false; }
+
+    // Пакетний розрахунок: масиви відстаней і ваг (structure-of-arrays) -> масив вартостей.
+    // За замовчуванням викликає calculateCost для кожної посилки.
+    virtual void calculateCosts(const double* distances, const double* weights, double* costs, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+            costs[i] = calculateCost(distances[i], weights[i]);
+    }
+
+    // Лічильник змін цін: стратегія, що змінює формулу під час роботи (перезавантаження
+    // тарифу), збільшує його після публікації нової формули. Кеші цін звіряються з ним.
+    static atomic<uint64_t>& pricingGeneration() {
+        static atomic<uint64_t> generation{0};
+        return generation;
+    }
+
+    virtual ~DeliveryStrategy() {}
+};
+
+// ===== Векторне ядро для лінійних тарифів: base + distance * perKm + weight * perKg =====
+inline void linearCostKernel(double base, double perKm, double perKg,
+                             const double* distances, const double* weights, double* costs, size_t count) {
+    size_t i = 0;
+#ifdef DELIVERY_USE_SSE2
+    const __m128d vBase = _mm_set1_pd(base);
+    const __m128d vKm = _mm_set1_pd(perKm);
+    const __m128d vKg = _mm_set1_pd(perKg);
+    for (; i + 2 <= count; i += 2) {
+        __m128d d = _mm_loadu_pd(distances + i);
+        __m128d w = _mm_loadu_pd(weights + i);
+        __m128d c = _mm_add_pd(_mm_add_pd(vBase, _mm_mul_pd(d, vKm)), _mm_mul_pd(w, vKg));
+        _mm_storeu_pd(costs + i, c);
+    }
+#endif
+    // Залишок (або вся робота, якщо SSE2 недоступний)
+    for (; i < count; ++i)
+        costs[i] = base + distances[i] * perKm + weights[i] * perKg;
+}
+
+// ===== Конкретна стратегія 1: Самовивіз =====
+class SelfPickupStrategy : public DeliveryStrategy {
+public:
+    double calculateCost(double distance, double weight) override {
+        // Самовивіз — безкоштовна доставка
+        return 0.0;
+    }
+    string getName() override {
+        return "Самовивіз";
+    }
+    bool isPickup() const override {
+        return true;
+    }
+    void calculateCosts(const double*, const double*, double* costs, size_t count) override {
+        for (size_t i = 0; i < count; ++i)
+            costs[i] = 0.0;
+    }
+};
+
+// ===== Конкретна стратегія 2: Зовнішня служба =====
+class ExternalDeliveryStrategy : public DeliveryStrategy {
+    static constexpr double BASE = 5.0;
+    static constexpr double PER_KM = 0.5;
+    static constexpr double PER_KG = 0.2;
+public:
+    double calculateCost(double distance, double weight) override {
+        // Формула може бути складною, але ми просто імітуємо:
+        return BASE + distance * PER_KM + weight * PER_KG;
+    }
+    string getName() override {
+        return "Зовнішня служба доставки";
+    }
+    void calculateCosts(const double* distances, const double* weights, double* costs, size_t count) override {
+        linearCostKernel(BASE, PER_KM, PER_KG, distances, weights, costs, count);
+    }
+};
+
+// ===== Конкретна стратегія 3: Власна служба =====
+class InternalDeliveryStrategy : public DeliveryStrategy {
+    static constexpr double BASE = 3.0;
+    static constexpr double PER_KM = 0.3;
+    static constexpr double PER_KG = 0.1;
+public:
+    double calculateCost(double distance, double weight) override {
+        // Власна служба може мати знижки або іншу логіку
+        return BASE + distance * PER_KM + weight * PER_KG;
+    }
+    string getName() override {
+        return "Власна служба доставки";
+    }
+    void calculateCosts(const double* distances, const double* weights, double* costs, size_t count) override {
+        linearCostKernel(BASE, PER_KM, PER_KG, distances, weights, costs, count);
+    }
+};
+
+// ===== Конкретна стратегія 4: Тариф із конфігураційного файлу =====
+//
+// Формат файлу (рядки з '#' — коментарі):
+//   name <назва тарифу>
+//   base <фіксована частина>
+//   distance <верхня межа, км | inf> <грн за км у цьому діапазоні>
+//   weight <верхня межа, кг | inf> <грн за кг у цьому діапазоні>
+// Діапазони задаються за зростанням меж; вартість — кусково-лінійна функція.
+// Межі й ставки мають бути додатними, фіксована частина — невід'ємною.
+
+// Скомпільована таблиця тарифу: плоскі масиви меж, ставок і накопиченої вартості
+struct TariffTable {
+    struct Bands {
+        vector<double> start;     // початок діапазону
+        vector<double> limit;     // кінець діапазону
+        vector<double> rate;      // ставка в діапазоні
+        vector<double> cumulative; // вартість на початку діапазону
+
+        double cost(double x) const {
+            if (limit.empty() || x <= 0)
+                return 0.0;
+            size_t i = upper_bound(limit.begin(), limit.end(), x) - limit.begin();
+            if (i == limit.size())
+                i = limit.size() - 1; // за межами останнього діапазону — остання ставка
+            return cumulative[i] + (x - start[i]) * rate[i];
+        }
+    };
+
+    string name;
+    double base = 0.0;
+    Bands distance;
+    Bands weight;
+
+    double cost(double d, double w) const {
+        return base + distance.cost(d) + weight.cost(w);
+    }
+};
+
+// Розбір конфігурації; повертає nullptr, якщо файл некоректний
+inline unique_ptr<TariffTable> compileTariff(istream& in, string& error) {
+    auto table = make_unique<TariffTable>();
+    vector<pair<double, double>> distanceBands, weightBands;
+    string line;
+    int lineNo = 0;
+
+    while (getline(in, line)) {
+        ++lineNo;
+        size_t hash = line.find('#');
+        if (hash != string::npos)
+            line.erase(hash);
+        istringstream ls(line);
+        string key;
+        if (!(ls >> key))
+            continue;
+
+        if (key == "name") {
+            getline(ls >> ws, table->name);
+        } else if (key == "base") {
+            if (!(ls >> table->base)) {
+                error = "рядок " + to_string(lineNo) + ": очікується число";
+                return nullptr;
+            }
+            if (!(table->base >= 0) || !isfinite(table->base)) {
+                error = "рядок " + to_string(lineNo) + ": фіксована частина має бути невід'ємною";
+                return nullptr;
+            }
+        } else if (key == "distance" || key == "weight") {
+            string limitText;
+            double rate;
+            if (!(ls >> limitText >> rate)) {
+                error = "рядок " + to_string(lineNo) + ": очікується <межа> <ставка>";
+                return nullptr;
+            }
+            double limit = numeric_limits<double>::infinity();
+            istringstream limitStream(limitText);
+            if (limitText != "inf" && !(limitStream >> limit)) {
+                error = "рядок " + to_string(lineNo) + ": некоректна межа '" + limitText + "'";
+                return nullptr;
+            }
+            // !(x > 0) відкидає також NaN
+            if (!(limit > 0)) {
+                error = "рядок " + to_string(lineNo) + ": межа має бути додатною";
+                return nullptr;
+            }
+            if (!(rate > 0) || !isfinite(rate)) {
+                error = "рядок " + to_string(lineNo) + ": ставка має бути додатною";
+                return nullptr;
+            }
+            auto& bands = key == "distance" ? distanceBands : weightBands;
+            if (!bands.empty() && limit <= bands.back().first) {
+                error = "рядок " + to_string(lineNo) + ": межі мають зростати";
+                return nullptr;
+            }
+            bands.push_back({limit, rate});
+        } else {
+            error = "рядок " + to_string(lineNo) + ": невідомий ключ '" + key + "'";
+            return nullptr;
+        }
+    }
+
+    auto compile = [](const vector<pair<double, double>>& src, TariffTable::Bands& dst) {
+        double start = 0.0, cumulative = 0.0;
+        for (auto& band : src) {
+            dst.start.push_back(start);
+            dst.limit.push_back(band.first);
+            dst.rate.push_back(band.second);
+            dst.cumulative.push_back(cumulative);
+            if (band.first != numeric_limits<double>::infinity())
+                cumulative += (band.first - start) * band.second;
+            start = band.first;
+        }
+    };
+    compile(distanceBands, table->distance);
+    compile(weightBands, table->weight);
+    return table;
+}
+
+class TariffDeliveryStrategy : public DeliveryStrategy {
+private:
+    string path;
+    // Поточна таблиця (RCU): оновлення публікує нову таблицю атомарною заміною
+    // вказівника, читач атомарно бере копію shared_ptr і тримає її, поки рахує.
+    // Стара таблиця звільняється, коли її відпускає останній читач, — скільки б
+    // той не рахував і як часто б не перезавантажувався тариф. Читачі не беруть
+    // м'ютексів стратегії; atomic_load/atomic_store для shared_ptr у стандартній
+    // бібліотеці захищені лише коротким внутрішнім спін-блокуванням.
+    shared_ptr<const TariffTable> current;
+    mutex writerMutex; // серіалізує лише тих, хто перезавантажує тариф
+
+public:
+    TariffDeliveryStrategy(const string& configPath) : path(configPath) {
+        string error;
+        if (!reload(error))
+            throw runtime_error("Не вдалося завантажити тариф " + path + ": " + error);
+    }
+
+    // Перечитує файл; у разі помилки залишає попередній тариф
+    bool reload(string& error) {
+        ifstream in(path);
+        if (!in) {
+            error = "файл не знайдено";
+            return false;
+        }
+        auto table = compileTariff(in, error);
+        if (!table)
+            return false;
+
+        lock_guard<mutex> lock(writerMutex);
+        atomic_store(&current, shared_ptr<const TariffTable>(move(table)));
+        pricingGeneration().fetch_add(1, memory_order_release);
+        return true;
+    }
+
+    double calculateCost(double distance, double weight) override {
+        return atomic_load(&current)->cost(distance, weight);
+    }
+
+    string getName() override {
+        return "Тариф: " + atomic_load(&current)->name;
+    }
+
+    void calculateCosts(const double* distances, const double* weights, double* costs, size_t count) override {
+        // Вся пачка рахується за однією версією тарифу
+        shared_ptr<const TariffTable> table = atomic_load(&current);
+        for (size_t i = 0; i < count; ++i)
+            costs[i] = table->cost(distances[i], weights[i]);
+    }
+};
+
+// ===== Сервіс відстаней за координатами =====
+struct GeoPoint {
+    double lat; // широта, градуси
+    double lon; // довгота, градуси
+};
+
+// Результат пакетного розрахунку: вартість для кожної пари (стратегія, склад, посилка)
+struct QuoteMatrix {
+    size_t strategies = 0;
+    size_t warehouses = 0;
+    size_t parcels = 0;
+    vector<double> distances; // [склад]
+    vector<double> costs;     // [стратегія][склад][посилка]
+
+    double at(size_t s, size_t w, size_t p) const {
+        return costs[(s * warehouses + w) * parcels + p];
+    }
+};
+
+// Пул потоків для пакетних розрахунків: потоки створюються один раз і чекають на
+// завдання. run() виконує останнє завдання пакета у потоці викликача і повертається,
+// коли виконано всі завдання цього пакета.
+class WorkerPool {
+private:
+    struct Batch {
+        size_t remaining;
+    };
+    struct Task {
+        function<void()> work;
+        Batch* batch;
+    };
+
+    vector<thread> workers;
+    deque<Task> tasks;
+    bool stopping = false;
+    mutex mtx;
+    condition_variable hasTask, batchDone;
+
+    void finish(Batch* batch) {
+        lock_guard<mutex> lock(mtx);
+        if (--batch->remaining == 0)
+            batchDone.notify_all();
+    }
+
+    void loop() {
+        for (;;) {
+            Task task;
+            {
+                unique_lock<mutex> lock(mtx);
+                hasTask.wait(lock, [&] { return stopping || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+                task = move(tasks.front());
+                tasks.pop_front();
+            }
+            task.work();
+            finish(task.batch);
+        }
+    }
+
+public:
+    explicit WorkerPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this] { loop(); });
+    }
+
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+        }
+        hasTask.notify_all();
+        for (auto& t : workers)
+            t.join();
+    }
+
+    size_t size() const { return workers.size(); }
+
+    void run(vector<function<void()>>& batchTasks) {
+        if (batchTasks.empty())
+            return;
+        Batch batch{batchTasks.size()};
+        {
+            lock_guard<mutex> lock(mtx);
+            for (size_t i = 0; i + 1 < batchTasks.size(); ++i)
+                tasks.push_back({move(batchTasks[i]), &batch});
+        }
+        hasTask.notify_all();
+        batchTasks.back()();
+        unique_lock<mutex> lock(mtx);
+        --batch.remaining;
+        batchDone.wait(lock, [&] { return batch.remaining == 0; });
+    }
+};
+
+class DistanceService {
+private:
+    static constexpr double EARTH_RADIUS_KM = 6371.0;
+    static constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+    static constexpr size_t MIN_PAIRS_PER_THREAD = 4096;
+    static constexpr size_t CACHE_BYPASS_PAIRS = MIN_PAIRS_PER_THREAD; // більші пакети — без кешу
+    static constexpr size_t CACHE_WAYS = 4;
+    static constexpr size_t DEFAULT_MAX_CACHE_ENTRIES = 1 << 12;
+    static constexpr double CELLS_PER_DEGREE = 1e5;   // клітинка сітки ~1.1 м
+
+    // Ключ пари — номери клітинок сітки для обох точок (квантовані широта й довгота)
+    struct PairKey {
+        int32_t lat1, lon1, lat2, lon2;
+        bool operator==(const PairKey& o) const {
+            return lat1 == o.lat1 && lon1 == o.lon1 && lat2 == o.lat2 && lon2 == o.lon2;
+        }
+    };
+    struct CacheSlot {
+        PairKey key{};
+        double km = 0;
+        bool used = false;
+        bool referenced = false;  // біт «годинника»: ставиться при влученні
+    };
+
+    size_t threadCount;
+    size_t setCount;              // кеш: setCount наборів по CACHE_WAYS записів (0 — вимкнено)
+    vector<CacheSlot> cache;
+    vector<uint8_t> clockHand;    // стрілка годинника для кожного набору
+    size_t cachedPairs = 0;
+    mutex cacheMutex;
+    WorkerPool pool;              // потік викликача + threadCount - 1 постійних потоків
+
+    // Відстань за формулою Гаверсинуса через libm (еталон і залишок векторного ядра)
+    static double haversineScalar(double lat1, double lon1, double lat2, double lon2) {
+        double p1 = lat1 * DEG_TO_RAD, p2 = lat2 * DEG_TO_RAD;
+        double dLat = (lat2 - lat1) * DEG_TO_RAD * 0.5;
+        double dLon = (lon2 - lon1) * DEG_TO_RAD * 0.5;
+        double sLat = sin(dLat), sLon = sin(dLon);
+        double a = sLat * sLat + cos(p1) * cos(p2) * sLon * sLon;
+        return 2.0 * EARTH_RADIUS_KM * asin(sqrt(min(a, 1.0)));
+    }
+
+#ifdef DELIVERY_USE_SSE2
+    // Многочлени від u = x² (наближення Чебишова, зведені до степенів u):
+    // sin(x)/x для |x| <= pi, cos(x) для |x| <= pi/2, asin(x)/x для |x| <= 0.5.
+    // Відносна похибка ~1e-15 — менше мікрометра на відстані.
+    static constexpr double SIN_POLY[10] = {
+        0.99999999999999867, -0.1666666666666535, 0.0083333333332989892,
+        -0.00019841269837409491, 2.7557318993471039e-06, -2.5052100276614461e-08,
+        1.6058867301775581e-10, -7.6447554977718544e-13, 2.7913762813227796e-15,
+        -7.2791649094019604e-18};
+    static constexpr double COS_POLY[9] = {
+        0.99999999999999933, -0.49999999999998468, 0.041666666666576105,
+        -0.0013888888886499917, 2.4801586966950425e-05, -2.7557292338714386e-07,
+        2.0875497918119333e-09, -1.1437853357677685e-11, 4.3655032487709277e-14};
+    static constexpr double ASIN_POLY[12] = {
+        0.99999999999999833, 0.16666666666770455, 0.074999999856143876,
+        0.044642865588734357, 0.030381676700051229, 0.022377318112194192,
+        0.017288483715674374, 0.014498014142736793, 0.0085965946316719014,
+        0.020454442501068117, -0.015227890014648441, 0.033978271484375003};
+
+    // Многочлен для двох значень u за схемою Горнера
+    template <size_t N>
+    static __m128d polynomial(const double (&c)[N], __m128d u) {
+        __m128d r = _mm_set1_pd(c[N - 1]);
+        for (size_t k = N - 1; k-- > 0;)
+            r = _mm_add_pd(_mm_mul_pd(r, u), _mm_set1_pd(c[k]));
+        return r;
+    }
+
+    static __m128d select(__m128d mask, __m128d a, __m128d b) {
+        return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+    }
+#endif
+
+    // Ядро Гаверсинуса над масивами (structure-of-arrays). З SSE2 — по дві пари за крок:
+    // sin, cos і asin рахуються многочленами, без викликів libm і розгалужень
+    // (asin(y) для y > 0.5 зводиться до pi/2 - 2 asin(sqrt((1 - y) / 2))).
+    // Координати — у градусах, широта в [-90, 90], довгота в [-180, 180].
+    static void haversineKernel(const double* lat1, const double* lon1,
+                                const double* lat2, const double* lon2,
+                                double* out, size_t count) {
+        size_t i = 0;
+#ifdef DELIVERY_USE_SSE2
+        const __m128d toRad = _mm_set1_pd(DEG_TO_RAD), halfToRad = _mm_set1_pd(DEG_TO_RAD * 0.5);
+        const __m128d one = _mm_set1_pd(1.0), half = _mm_set1_pd(0.5);
+        const __m128d halfPi = _mm_set1_pd(1.57079632679489661923);
+        const __m128d diameter = _mm_set1_pd(2.0 * EARTH_RADIUS_KM);
+        for (; i + 2 <= count; i += 2) {
+            __m128d la1 = _mm_loadu_pd(lat1 + i), la2 = _mm_loadu_pd(lat2 + i);
+            __m128d p1 = _mm_mul_pd(la1, toRad), p2 = _mm_mul_pd(la2, toRad);
+            __m128d dLat = _mm_mul_pd(_mm_sub_pd(la2, la1), halfToRad);
+            __m128d dLon = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(lon2 + i), _mm_loadu_pd(lon1 + i)), halfToRad);
+            __m128d sLat = _mm_mul_pd(dLat, polynomial(SIN_POLY, _mm_mul_pd(dLat, dLat)));
+            __m128d sLon = _mm_mul_pd(dLon, polynomial(SIN_POLY, _mm_mul_pd(dLon, dLon)));
+            __m128d c1 = polynomial(COS_POLY, _mm_mul_pd(p1, p1));
+            __m128d c2 = polynomial(COS_POLY, _mm_mul_pd(p2, p2));
+            __m128d a = _mm_add_pd(_mm_mul_pd(sLat, sLat), _mm_mul_pd(_mm_mul_pd(c1, c2), _mm_mul_pd(sLon, sLon)));
+            __m128d y = _mm_sqrt_pd(_mm_min_pd(_mm_max_pd(a, _mm_setzero_pd()), one));
+
+            __m128d small = _mm_cmple_pd(y, half);
+            __m128d w = select(small, y, _mm_sqrt_pd(_mm_mul_pd(_mm_sub_pd(one, y), half)));
+            __m128d r = _mm_mul_pd(w, polynomial(ASIN_POLY, _mm_mul_pd(w, w)));
+            __m128d angle = select(small, r, _mm_sub_pd(halfPi, _mm_add_pd(r, r)));
+            _mm_storeu_pd(out + i, _mm_mul_pd(diameter, angle));
+        }
+#endif
+        // Залишок (або вся робота, якщо SSE2 недоступний)
+        for (; i < count; ++i)
+            out[i] = haversineScalar(lat1[i], lon1[i], lat2[i], lon2[i]);
+    }
+
+    // Розподіляє обчислення між потоками пулу
+    void computeParallel(const double* lat1, const double* lon1,
+                         const double* lat2, const double* lon2,
+                         double* out, size_t count) {
+        size_t threads = min(threadCount, max<size_t>(count / MIN_PAIRS_PER_THREAD, 1));
+        if (threads == 1) {
+            haversineKernel(lat1, lon1, lat2, lon2, out, count);
+            return;
+        }
+        vector<function<void()>> tasks;
+        size_t step = (count + threads - 1) / threads;
+        for (size_t begin = 0; begin < count; begin += step) {
+            size_t n = min(step, count - begin);
+            tasks.push_back([=] {
+                haversineKernel(lat1 + begin, lon1 + begin, lat2 + begin, lon2 + begin, out + begin, n);
+            });
+        }
+        pool.run(tasks);
+    }
+
+    // Кількість наборів — степінь двійки, щоб номер набору брався маскою
+    static size_t cacheSets(size_t maxEntries) {
+        if (maxEntries == 0)
+            return 0;
+        size_t sets = 1;
+        while (sets * CACHE_WAYS < maxEntries)
+            sets *= 2;
+        return sets;
+    }
+
+    static int32_t cell(double degrees) {
+        return static_cast<int32_t>(lrint(degrees * CELLS_PER_DEGREE));
+    }
+
+    static PairKey keyOf(const GeoPoint& from, const GeoPoint& to) {
+        return {cell(from.lat), cell(from.lon), cell(to.lat), cell(to.lon)};
+    }
+
+    // Номер набору за перемішаним ключем (setCount — степінь двійки)
+    size_t setOf(const PairKey& k) const {
+        uint64_t h = (uint64_t(uint32_t(k.lat1)) << 32 | uint32_t(k.lon1)) * 0x9E3779B97F4A7C15ULL;
+        h = (h ^ (h >> 32) ^ (uint64_t(uint32_t(k.lat2)) << 32 | uint32_t(k.lon2))) * 0xC2B2AE3D27D4EB4FULL;
+        return static_cast<size_t>(h ^ (h >> 32)) & (setCount - 1);
+    }
+
+    // Під cacheMutex
+    bool lookup(const PairKey& key, double& km) {
+        CacheSlot* set = &cache[setOf(key) * CACHE_WAYS];
+        for (size_t w = 0; w < CACHE_WAYS; ++w) {
+            if (set[w].used && set[w].key == key) {
+                set[w].referenced = true;
+                km = set[w].km;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Під cacheMutex. Витіснення «годинником»: стрілка скидає біт звертання
+    // у записів, до яких зверталися, і замінює перший запис без нього
+    void insert(const PairKey& key, double km) {
+        size_t s = setOf(key);
+        CacheSlot* set = &cache[s * CACHE_WAYS];
+        for (size_t w = 0; w < CACHE_WAYS; ++w) {
+            if (set[w].used && set[w].key == key)
+                return;
+        }
+        uint8_t& hand = clockHand[s];
+        while (set[hand].used && set[hand].referenced) {
+            set[hand].referenced = false;
+            hand = static_cast<uint8_t>((hand + 1) % CACHE_WAYS);
+        }
+        if (!set[hand].used)
+            ++cachedPairs;
+        set[hand].key = key;
+        set[hand].km = km;
+        set[hand].used = true;
+        set[hand].referenced = false;
+        hand = static_cast<uint8_t>((hand + 1) % CACHE_WAYS);
+    }
+
+public:
+    // maxCacheEntries = 0 вимикає кеш
+    DistanceService(size_t threads = thread::hardware_concurrency(),
+                    size_t maxCacheEntries = DEFAULT_MAX_CACHE_ENTRIES)
+        : threadCount(max<size_t>(threads, 1)),
+          setCount(cacheSets(maxCacheEntries)),
+          cache(setCount * CACHE_WAYS),
+          clockHand(setCount, 0),
+          pool(threadCount - 1) {}
+
+    // Відстані для пар from[i] -> to[i]. Малі пакети (окремі запити, кошик) спершу
+    // шукаються в кеші; пари з однієї клітинки сітки мають спільний запис (похибка до ~1.5 м).
+    // Великі пакети кеш оминають: векторне ядро на всіх потоках дешевше за пошук
+    void distances(const GeoPoint* from, const GeoPoint* to, double* out, size_t count) {
+        if (count >= CACHE_BYPASS_PAIRS || setCount == 0) {
+            vector<double> lat1(count), lon1(count), lat2(count), lon2(count);
+            for (size_t i = 0; i < count; ++i) {
+                lat1[i] = from[i].lat; lon1[i] = from[i].lon;
+                lat2[i] = to[i].lat;   lon2[i] = to[i].lon;
+            }
+            computeParallel(lat1.data(), lon1.data(), lat2.data(), lon2.data(), out, count);
+            return;
+        }
+
+        vector<PairKey> keys(count);
+        vector<size_t> missIndex;
+        {
+            lock_guard<mutex> lock(cacheMutex);
+            for (size_t i = 0; i < count; ++i) {
+                keys[i] = keyOf(from[i], to[i]);
+                if (!lookup(keys[i], out[i]))
+                    missIndex.push_back(i);
+            }
+        }
+        if (missIndex.empty())
+            return;
+
+        // Промахи збираємо у стовпці і рахуємо одним викликом ядра
+        size_t n = missIndex.size();
+        vector<double> lat1(n), lon1(n), lat2(n), lon2(n), result(n);
+        for (size_t j = 0; j < n; ++j) {
+            size_t i = missIndex[j];
+            lat1[j] = from[i].lat; lon1[j] = from[i].lon;
+            lat2[j] = to[i].lat;   lon2[j] = to[i].lon;
+        }
+        haversineKernel(lat1.data(), lon1.data(), lat2.data(), lon2.data(), result.data(), n);
+
+        lock_guard<mutex> lock(cacheMutex);
+        for (size_t j = 0; j < n; ++j) {
+            out[missIndex[j]] = result[j];
+            insert(keys[missIndex[j]], result[j]);
+        }
+    }
+
+    // Одна пара — без проміжних масивів
+    double distance(const GeoPoint& from, const GeoPoint& to) {
+        if (setCount == 0)
+            return haversineScalar(from.lat, from.lon, to.lat, to.lon);
+        PairKey key = keyOf(from, to);
+        double km;
+        {
+            lock_guard<mutex> lock(cacheMutex);
+            if (lookup(key, km))
+                return km;
+        }
+        km = haversineScalar(from.lat, from.lon, to.lat, to.lon);
+        lock_guard<mutex> lock(cacheMutex);
+        insert(key, km);
+        return km;
+    }
+
+    // Кошик (ваги посилок) x склади x стратегії — одним пакетним викликом
+    QuoteMatrix quote(const vector<GeoPoint>& warehouses, const GeoPoint& customer,
+                      const vector<double>& parcelWeights, const vector<DeliveryStrategy*>& strategies) {
+        QuoteMatrix m;
+        m.strategies = strategies.size();
+        m.warehouses = warehouses.size();
+        m.parcels = parcelWeights.size();
+
+        vector<GeoPoint> customers(warehouses.size(), customer);
+        m.distances.resize(warehouses.size());
+        distances(warehouses.data(), customers.data(), m.distances.data(), warehouses.size());
+
+        // Стовпці для стратегій: кожна пара (склад, посилка)
+        size_t pairs = m.warehouses * m.parcels;
+        vector<double> d(pairs), w(pairs);
+        for (size_t i = 0; i < m.warehouses; ++i) {
+            for (size_t j = 0; j < m.parcels; ++j) {
+                d[i * m.parcels + j] = m.distances[i];
+                w[i * m.parcels + j] = parcelWeights[j];
+            }
+        }
+        m.costs.resize(m.strategies * pairs);
+        for (size_t s = 0; s < m.strategies; ++s)
+            strategies[s]->calculateCosts(d.data(), w.data(), m.costs.data() + s * pairs, pairs);
+        return m;
+    }
+
+    size_t cacheSize() {
+        lock_guard<mutex> lock(cacheMutex);
+        return cachedPairs;
+    }
+
+    size_t cacheLimit() const { return cache.size(); }
+};
+
+// ===== Рушій котирувань: усі стратегії за один прохід =====
+struct DeliveryQuote {
+    DeliveryStrategy* strategy;
+    double cost;
+};
+
+struct QuoteConstraints {
+    double maxCost = numeric_limits<double>::infinity();
+    bool excludePickup = false;
+};
+
+// Не потокобезпечний: кожен потік обробки запитів тримає власний рушій
+class DeliveryQuoteEngine {
+private:
+    vector<DeliveryStrategy*> strategies;
+    double distanceStep;  // крок квантування відстані, км
+    double weightStep;    // крок квантування ваги, кг
+    size_t maxCachedKeys;
+    // Ключ (квантована відстань, квантована вага) -> зсув у memoCosts
+    unordered_map<uint64_t, size_t> memo;
+    vector<double> memoCosts; // по strategies.size() значень на ключ
+    vector<double> uncachedCosts; // для запитів, що не вміщаються в ключ
+    uint64_t cachedGeneration = 0; // pricingGeneration, за якою пораховано memo
+
+    // Обидві квантовані величини мають вміщатися в 32 біти, інакше ключі збігатимуться
+    static bool fitsKey(double q) {
+        return q > -2147483648.0 && q < 2147483647.0;
+    }
+
+    static uint64_t makeKey(int64_t d, int64_t w) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(d)) << 32) | static_cast<uint32_t>(w);
+    }
+
+    const double* costsFor(double distance, double weight) {
+        uint64_t generation = DeliveryStrategy::pricingGeneration().load(memory_order_acquire);
+        if (generation != cachedGeneration) {
+            clearCache(); // тариф перезавантажено — кешовані ціни застаріли
+            cachedGeneration = generation;
+        }
+        double qDistance = distance / distanceStep, qWeight = weight / weightStep;
+        if (!fitsKey(qDistance) || !fitsKey(qWeight)) {
+            // Поза діапазоном ключа (або NaN) — рахуємо напряму, без кешу
+            uncachedCosts.resize(strategies.size());
+            for (size_t i = 0; i < strategies.size(); ++i)
+                uncachedCosts[i] = strategies[i]->calculateCost(distance, weight);
+            return uncachedCosts.data();
+        }
+        int64_t d = llround(qDistance);
+        int64_t w = llround(qWeight);
+        uint64_t key = makeKey(d, w);
+        auto it = memo.find(key);
+        if (it != memo.end())
+            return memoCosts.data() + it->second;
+
+        if (memo.size() >= maxCachedKeys)
+            clearCache();
+        // Рахуємо у квантованій точці, щоб кешовані ціни не залежали від порядку запитів
+        double qd = d * distanceStep, qw = w * weightStep;
+        size_t offset = memoCosts.size();
+        for (auto* s : strategies)
+            memoCosts.push_back(s->calculateCost(qd, qw));
+        memo.emplace(key, offset);
+        return memoCosts.data() + offset;
+    }
+
+public:
+    DeliveryQuoteEngine(double distanceStep = 0.1, double weightStep = 0.01, size_t maxCachedKeys = 100000)
+        : distanceStep(distanceStep), weightStep(weightStep), maxCachedKeys(maxCachedKeys) {}
+
+    void registerStrategy(DeliveryStrategy* s) {
+        strategies.push_back(s);
+        clearCache();
+    }
+
+    // Перезавантаження тарифу скидає кеш автоматично (через pricingGeneration);
+    // явний виклик потрібен лише для стратегій, що змінюють ціни інакше
+    void clearCache() {
+        memo.clear();
+        memoCosts.clear();
+    }
+
+    // Заповнює out варіантами, що відповідають обмеженням, від найдешевшого.
+    // out перевикористовується між викликами, тому гарячий шлях не виділяє пам'ять.
+    size_t quote(double distance, double weight, const QuoteConstraints& constraints, vector<DeliveryQuote>& out) {
+        out.clear();
+        const double* costs = costsFor(distance, weight);
+        for (size_t i = 0; i < strategies.size(); ++i) {
+            if (constraints.excludePickup && strategies[i]->isPickup())
+                continue;
+            if (costs[i] > constraints.maxCost)
+                continue;
+            out.push_back({strategies[i], costs[i]});
+        }
+        sort(out.begin(), out.end(), [](const DeliveryQuote& a, const DeliveryQuote& b) {
+            return a.cost < b.cost;
+        });
+        return out.size();
+    }
+
+    // Найдешевший варіант; false, якщо жодна стратегія не підходить
+    bool cheapest(double distance, double weight, const QuoteConstraints& constraints, DeliveryQuote& best) {
+        const double* costs = costsFor(distance, weight);
+        bool found = false;
+        for (size_t i = 0; i < strategies.size(); ++i) {
+            if (constraints.excludePickup && strategies[i]->isPickup())
+                continue;
+            if (costs[i] > constraints.maxCost || (found && costs[i] >= best.cost))
+                continue;
+            best = {strategies[i], costs[i]};
+            found = true;
+        }
+        return found;
+    }
+};
+
+// ===== Контекст, який використовує стратегію =====
+class DeliveryContext {
+private:
+    DeliveryStrategy* strategy;  // поточна стратегія доставки
+    DistanceService* distances;  // сервіс відстаней за координатами
+public:
+    DeliveryContext(DeliveryStrategy* s = nullptr, DistanceService* d = nullptr)
+        : strategy(s), distances(d) {}
+
+    void setStrategy(DeliveryStrategy* s) {
+        strategy = s;
+    }
+
+    void setDistanceService(DistanceService* d) {
+        distances = d;
+    }
+
+    // Розрахунок за координатами складу і клієнта
+    void calculate(const GeoPoint& from, const GeoPoint& to, double weight) {
+        if (!distances) {
+            TLOG(Error) << "❌ Сервіс відстаней не задано!\n";
+            return;
+        }
+        calculate(distances->distance(from, to), weight);
+    }
+
+    void calculate(double distance, double weight) {
+        static const telemetry::Counter quotes("delivery.quote");
+        if (!strategy) {
+            TLOG(Error) << "❌ Стратегію не вибрано!\n";
+            return;
+        }
+        double cost = strategy->calculateCost(distance, weight);
+        quotes.add();
+        TLOG(Info) << "Обрана стратегія: " << strategy->getName() << "\n"
+                   << "Відстань: " << distance << " км, Вага: " << weight << " кг\n"
+                   << "Вартість доставки: " << cost << " грн\n\n";
+    }
+};
+
+// ===== Клієнтський код =====
+int main() {
+#ifdef _WIN32
+    SetConsoleOutputCP(65001);
+#endif
+    // Стратегії
+    SelfPickupStrategy selfPickup;
+    ExternalDeliveryStrategy externalDelivery;
+    InternalDeliveryStrategy internalDelivery;
+
+    // Контекст
+    DeliveryContext context;
+
+    cout << "=== Розрахунок вартості доставки ===\n\n";
+
+    // 1️Самовивіз
+    context.setStrategy(&selfPickup);
+    context.calculate(10, 5);
+
+    // 2️Зовнішня служба
+    context.setStrategy(&externalDelivery);
+    context.calculate(10, 5);
+
+    // 3️Власна служба
+    context.setStrategy(&internalDelivery);
+    context.calculate(10, 5);
+
+    // 4️Тариф із конфігураційного файлу з гарячим перезавантаженням
+    const string tariffPath = (filesystem::temp_directory_path() / "lab7_tariff.cfg").string();
+    {
+        ofstream cfg(tariffPath);
+        cfg << "name Базовий\n"
+               "base 4.0\n"
+               "distance 5 0.8     # перші 5 км\n"
+               "distance 50 0.4\n"
+               "distance inf 0.2\n"
+               "weight 10 0.1\n"
+               "weight inf 0.3\n";
+    }
+    TariffDeliveryStrategy tariffDelivery(tariffPath);
+    context.setStrategy(&tariffDelivery);
+    context.calculate(10, 5);
+
+    {
+        ofstream cfg(tariffPath);
+        cfg << "name Акційний\n"
+               "base 2.0\n"
+               "distance inf 0.3\n"
+               "weight inf 0.1\n";
+    }
+    string error;
+    if (!tariffDelivery.reload(error))
+        TLOG(Error) << "Помилка перезавантаження тарифу: " << error << endl;
+    context.calculate(10, 5);
+
+    {
+        ofstream cfg(tariffPath);
+        cfg << "name Зламаний\n"
+               "distance inf 0     # нульова ставка\n";
+    }
+    if (!tariffDelivery.reload(error)) {
+        telemetry::flush();
+        cout << "Некоректний тариф відхилено (" << error << "), діє " << tariffDelivery.getName() << "\n";
+    }
+
+    // 5️Відстань за координатами і пакетний розрахунок для кошика
+    DistanceService distanceService;
+    GeoPoint customer{50.4501, 30.5234};                     // Київ
+    vector<GeoPoint> warehouses = {{50.4547, 30.5238},       // склад у центрі
+                                   {49.8397, 24.0297},       // Львів
+                                   {46.4825, 30.7233}};      // Одеса
+    context.setDistanceService(&distanceService);
+    context.setStrategy(&externalDelivery);
+    context.calculate(warehouses[1], customer, 5);
+    telemetry::flush(); // журнал розрахунків виводиться у фоні — вивантажуємо перед прямим виводом
+
+    QuoteMatrix quotes = distanceService.quote(warehouses, customer, {1.0, 5.0, 12.5},
+                                               {&selfPickup, &externalDelivery, &internalDelivery});
+    cout << "Кошик x склади x стратегії (" << quotes.costs.size() << " цін):\n";
+    for (size_t w = 0; w < quotes.warehouses; ++w) {
+        cout << "  Склад " << w << " (" << quotes.distances[w] << " км):";
+        for (size_t s = 0; s < quotes.strategies; ++s)
+            cout << " " << quotes.at(s, w, quotes.parcels - 1);
+        cout << " грн\n";
+    }
+
+    // Великі пакети рахуються постійними потоками пулу в обхід кешу
+    vector<GeoPoint> origins, targets;
+    for (int i = 0; i < 200000; ++i) {
+        origins.push_back({44.0 + (i % 400) * 0.02, 22.0 + (i / 400) * 0.03});
+        targets.push_back(customer);
+    }
+    vector<double> batchKm(origins.size());
+    for (int round = 0; round < 3; ++round) {
+        auto batchStart = chrono::steady_clock::now();
+        distanceService.distances(origins.data(), targets.data(), batchKm.data(), origins.size());
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - batchStart).count();
+        cout << "Пакет " << origins.size() << " відстаней: " << ms << " мс, у кеші "
+             << distanceService.cacheSize() << " з " << distanceService.cacheLimit() << "\n";
+    }
+
+    // Окремі запити з повторюваними парами: влучання в кеш проти повторного обчислення
+    DistanceService uncached(1, 0);
+    auto perCall = [&](DistanceService& service) {
+        const int calls = 400000;
+        double sink = 0;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < calls; ++i)
+            sink += service.distance(origins[i % 1000], customer);
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / calls;
+        return sink > 0 ? ns : 0.0;
+    };
+    double uncachedNs = perCall(uncached);
+    double cachedNs = perCall(distanceService);
+    cout << "Окремий запит: " << cachedNs << " нс з кешем, " << uncachedNs << " нс без кешу (у кеші "
+         << distanceService.cacheSize() << " з " << distanceService.cacheLimit() << ")\n";
+    cout << endl;
+
+    // 6️Усі стратегії одним проходом: рейтинг і найдешевший варіант
+    DeliveryQuoteEngine engine;
+    engine.registerStrategy(&selfPickup);
+    engine.registerStrategy(&externalDelivery);
+    engine.registerStrategy(&internalDelivery);
+    engine.registerStrategy(&tariffDelivery);
+
+    QuoteConstraints noPickup;
+    noPickup.excludePickup = true;
+    noPickup.maxCost = 10.0;
+    vector<DeliveryQuote> ranked;
+    engine.quote(10, 5, noPickup, ranked);
+    cout << "Варіанти без самовивозу до " << noPickup.maxCost << " грн:\n";
+    for (auto& q : ranked)
+        cout << "  " << q.strategy->getName() << ": " << q.cost << " грн\n";
+
+    const int quoteCount = 1000000;
+    DeliveryQuote best{nullptr, 0};
+    double checksum = 0;
+    auto quoteStart = chrono::steady_clock::now();
+    for (int i = 0; i < quoteCount; ++i) {
+        if (engine.cheapest(1.0 + (i % 300) * 0.5, 0.5 + (i % 20), noPickup, best))
+            checksum += best.cost;
+    }
+    double quoteNs = chrono::duration<double, nano>(chrono::steady_clock::now() - quoteStart).count() / quoteCount;
+    cout << "Найдешевший варіант: у середньому " << quoteNs << " нс на запит (контрольна сума " << checksum << ")\n";
+
+    // Кеш рушія звіряється з версією цін: після перезавантаження тарифу нова ціна видна одразу
+    {
+        ofstream cfg(tariffPath);
+        cfg << "name Подорожчання\n"
+               "base 6.0\n"
+               "distance inf 0.5\n"
+               "weight inf 0.2\n";
+    }
+    if (!tariffDelivery.reload(error))
+        TLOG(Error) << "Помилка перезавантаження тарифу: " << error << endl;
+
+    // Часті перезавантаження під навантаженням: читач завжди бачить цілу версію,
+    // стара таблиця живе, доки її тримає хоч один розрахунок
+    {
+        atomic<bool> readersStop{false}, torn{false};
+        vector<thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&] {
+                double d[2] = {10, 10}, w[2] = {5, 5}, c[2];
+                while (!readersStop.load()) {
+                    tariffDelivery.calculateCosts(d, w, c, 2);
+                    // 10 км, 5 кг: "Акційний" — 5.5 грн, "Подорожчання" — 12 грн
+                    if (c[0] != c[1] || (fabs(c[0] - 5.5) > 1e-9 && fabs(c[0] - 12.0) > 1e-9))
+                        torn = true;
+                }
+            });
+        }
+        const char* variants[2] = {"name Акційний\nbase 2.0\ndistance inf 0.3\nweight inf 0.1\n",
+                                   "name Подорожчання\nbase 6.0\ndistance inf 0.5\nweight inf 0.2\n"};
+        int reloads = 0;
+        for (int i = 0; i < 200; ++i) {
+            { ofstream cfg(tariffPath); cfg << variants[i % 2]; }
+            reloads += tariffDelivery.reload(error);
+        }
+        readersStop = true;
+        for (auto& t : readers)
+            t.join();
+        cout << "Перезавантажень під навантаженням: " << reloads << " з 200, ціни узгоджені: "
+             << (torn ? "НІ" : "так") << "\n";
+    }
+    remove(tariffPath.c_str());
+    engine.quote(10, 5, QuoteConstraints{}, ranked);
+    for (auto& q : ranked) {
+        if (q.strategy == &tariffDelivery)
+            cout << "Після перезавантаження: " << q.strategy->getName() << " " << q.cost << " грн (напряму "
+                 << tariffDelivery.calculateCost(10, 5) << " грн)\n";
+    }
+    DeliveryQuote farthest{nullptr, 0};
+    if (engine.cheapest(1e12, 5, QuoteConstraints{}, farthest))
+        cout << "Відстань поза діапазоном ключа кешу (1e12 км) рахується напряму: " << farthest.strategy->getName() << "\n";
+    cout << endl;
+
+    // 7️Пакетний розрахунок проти поштучних віртуальних викликів
+    cout << "=== Пакетний розрахунок вартості ===\n\n";
+    const size_t count = 1000000;
+    vector<double> distances(count), weights(count), costs(count);
+    for (size_t i = 0; i < count; ++i) {
+        distances[i] = 1.0 + (i % 500);
+        weights[i] = 0.5 + (i % 40) * 0.25;
+    }
+
+    DeliveryStrategy* strategies[] = {&externalDelivery, &internalDelivery};
+    for (DeliveryStrategy* s : strategies) {
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+            costs[i] = s->calculateCost(distances[i], weights[i]);
+        double single = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        double check = costs[count - 1];
+
+        start = chrono::steady_clock::now();
+        s->calculateCosts(distances.data(), weights.data(), costs.data(), count);
+        double batch = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << s->getName() << ": поштучно " << single << " мс, пакетно " << batch << " мс"
+             << (check == costs[count - 1] ? "" : " (результати відрізняються!)") << endl;
+    }
+
+    telemetry::Telemetry::instance().report(cout);
+
+    return 0;
+}
@@ -1,154 +1,1723 @@
-#include <iostream>
-#include <string>
-#include <map>
-#include <windows.h>
-
-using namespace std;
-
-// === Абстрактний базовий клас ===
-class EntityUpdater {
-public:
-    virtual ~EntityUpdater() = default;
-
-    // --- Шаблонний метод ---
-    void update(int entityId, map<string, string> newData) {
-        auto entity = getEntity(entityId);
-
-        if (!validateData(entity, newData)) {
-            onValidationFailed(entity, newData);
-            cout << "Validation failed. Update aborted.\n";
-            return;
-        }
-
-        auto request = buildSaveRequest(entity, newData);
-        auto response = sendRequest(request);
-        auto finalResponse = formatResponse(response, entity);
-
-        afterUpdateHook(entity, finalResponse);
-        cout << "Update complete.\n\n";
-    }
-
-protected:
-    // === Абстрактні методи (кроки алгоритму) ===
-    virtual map<string, string> getEntity(int entityId) = 0;
-    virtual bool validateData(map<string, string>& entity, map<string, string>& newData) = 0;
-    virtual map<string, string> buildSaveRequest(map<string, string>& entity, map<string, string>& newData) = 0;
-    virtual map<string, string> sendRequest(map<string, string>& request) = 0;
-
-    // === Методи за замовчуванням ===
-    virtual map<string, string> formatResponse(map<string, string>& response, map<string, string>& entity) {
-        return {{"status", "success"}, {"code", "200"}};
-    }
-
-    // === Хуки (точки розширення) ===
-    virtual void onValidationFailed(map<string, string>& entity, map<string, string>& newData) {}
-    virtual void afterUpdateHook(map<string, string>& entity, map<string, string>& response) {}
-};
-
-
-// === Реалізація для Product ===
-class ProductUpdater : public EntityUpdater {
-protected:
-    map<string, string> getEntity(int entityId) override {
-        cout << "[Product] Отримання продукту ID: " << entityId << endl;
-        return {{"id", to_string(entityId)}, {"name", "Laptop"}};
-    }
-
-    bool validateData(map<string, string>& entity, map<string, string>& newData) override {
-        cout << "[Product] Перевірка валідності даних...\n";
-        if (newData["price"].empty() || stoi(newData["price"]) <= 0)
-            return false;
-        return true;
-    }
-
-    void onValidationFailed(map<string, string>& entity, map<string, string>& newData) override {
-        cout << "[Product] Валідація не пройдена — надсилаємо сповіщення адміністратору в месенджер.\n";
-    }
-
-    map<string, string> buildSaveRequest(map<string, string>& entity, map<string, string>& newData) override {
-        cout << "[Product] Формування запиту для збереження...\n";
-        return {{"product_id", entity["id"]}, {"data", newData["price"]}};
-    }
-
-    map<string, string> sendRequest(map<string, string>& request) override {
-        cout << "[Product] Надсилання запиту...\n";
-        return {{"status", "ok"}};
-    }
-};
-
-
-// === Реалізація для User ===
-class UserUpdater : public EntityUpdater {
-protected:
-    map<string, string> getEntity(int entityId) override {
-        cout << "[User] Отримання користувача ID: " << entityId << endl;
-        return {{"id", to_string(entityId)}, {"name", "Danylo"}, {"email", "user@mail.com"}};
-    }
-
-    bool validateData(map<string, string>& entity, map<string, string>& newData) override {
-        cout << "[User] Перевірка даних...\n";
-        if (newData.find("email") != newData.end()) {
-            cout << "[User] Поле 'email' заборонено змінювати! Видаляємо його.\n";
-            newData.erase("email");
-        }
-        return true;
-    }
-
-    map<string, string> buildSaveRequest(map<string, string>& entity, map<string, string>& newData) override {
-        cout << "[User] Формування запиту на оновлення користувача...\n";
-        return {{"user_id", entity["id"]}, {"update_name", newData["name"]}};
-    }
-
-    map<string, string> sendRequest(map<string, string>& request) override {
-        cout << "[User] Надсилання запиту...\n";
-        return {{"status", "updated"}};
-    }
-};
-
-
-// === Реалізація для Order ===
-class OrderUpdater : public EntityUpdater {
-protected:
-    map<string, string> getEntity(int entityId) override {
-        cout << "[Order] Отримання замовлення ID: " << entityId << endl;
-        return {{"id", to_string(entityId)}, {"item", "Laptop"}, {"total", "1500"}};
-    }
-
-    bool validateData(map<string, string>& entity, map<string, string>& newData) override {
-        cout << "[Order] Валідація даних...\n";
-        return true;
-    }
-
-    map<string, string> buildSaveRequest(map<string, string>& entity, map<string, string>& newData) override {
-        cout << "[Order] Формування запиту для оновлення замовлення...\n";
-        return {{"order_id", entity["id"]}, {"status", newData["status"]}};
-    }
-
-    map<string, string> sendRequest(map<string, string>& request) override {
-        cout << "[Order] Надсилання запиту...\n";
-        return {{"status", "success"}};
-    }
-
-    map<string, string> formatResponse(map<string, string>& response, map<string, string>& entity) override {
-        cout << "[Order] Формування розширеної відповіді...\n";
-        string orderInfo = "{id: " + entity["id"] + ", item: " + entity["item"] + ", total: " + entity["total"] + "}";
-        return {{"status", "success"}, {"code", "200"}, {"order_data", orderInfo}};
-    }
-};
-
-
-// === Клієнтський код ===
-int main() {
-    SetConsoleOutputCP(65001);
-    cout << "\n---Оновлення продукту ---\n";
-    ProductUpdater product;
-    product.update(1, {{"price", "-10"}});
-
-    cout << "\n---Оновлення користувача ---\n";
-    UserUpdater user;
-    user.update(2, {{"name", "Ivan"}, {"email", "new@mail.com"}});
-
-    cout << "\n---Оновлення замовлення ---\n";
-    OrderUpdater order;
-    order.update(3, {{"status", "shipped"}});
-}
+#include <iostream>
+#include <string>
+#include <map>
+#include <vector>
+#include <initializer_list>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fstream>
+#include <filesystem>
+#include <array>
+#include <iomanip>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "../common/alloc_counter.h"
+#include "../common/telemetry.h"
+
+using namespace std;
+
+// === Схема сутності: імена полів перетворюються на індекси один раз ===
+class EntitySchema {
+    vector<string> names;
+
+public:
+    EntitySchema(initializer_list<const char*> fields) : names(fields.begin(), fields.end()) {}
+
+    size_t size() const { return names.size(); }
+    const string& name(int id) const { return names[id]; }
+
+    // Індекс поля або -1, якщо такого поля немає
+    int find(const string& field) const {
+        for (size_t i = 0; i < names.size(); ++i)
+            if (names[i] == field)
+                return (int)i;
+        return -1;
+    }
+};
+
+// === Плаский запис: значення полів лежать поспіль у порядку схеми ===
+// Короткі значення std::string зберігає всередині себе, тож повторне
+// використання запису не виділяє пам'ять.
+class Record {
+    const EntitySchema* schema;
+    vector<string> values;
+    uint32_t present = 0; // бітова маска заданих полів (до 32 полів у схемі)
+    uint64_t version = 0; // версія рядка у сховищі (0 — невідома)
+
+public:
+    explicit Record(const EntitySchema* s) : schema(s), values(s->size()) {}
+
+    const EntitySchema& getSchema() const { return *schema; }
+
+    uint64_t getVersion() const { return version; }
+    void setVersion(uint64_t v) { version = v; }
+
+    bool has(int id) const { return (present >> id) & 1u; }
+
+    // Для відсутнього поля повертає порожній рядок і нічого не вставляє
+    const string& get(int id) const { return values[id]; }
+
+    void set(int id, const string& value) {
+        values[id].assign(value);
+        present |= 1u << id;
+    }
+
+    void set(int id, const char* value) {
+        values[id].assign(value);
+        present |= 1u << id;
+    }
+
+    void erase(int id) {
+        values[id].clear();
+        present &= ~(1u << id);
+    }
+
+    // Очищує значення, зберігаючи виділені буфери
+    void clear() {
+        for (size_t i = 0; i < values.size(); ++i)
+            if (has((int)i))
+                values[i].clear();
+        present = 0;
+        version = 0;
+    }
+
+    // Копіює значення з запису тієї ж схеми у вже наявні буфери
+    void assign(const Record& other) {
+        clear();
+        for (size_t i = 0; i < values.size(); ++i)
+            if (other.has((int)i))
+                set((int)i, other.values[i]);
+        version = other.version;
+    }
+
+    // Сумісність зі старим API на map<string, string>
+    bool set(const string& field, const string& value) {
+        int id = schema->find(field);
+        if (id < 0)
+            return false;
+        set(id, value);
+        return true;
+    }
+
+    map<string, string> toMap() const {
+        map<string, string> result;
+        for (size_t i = 0; i < values.size(); ++i)
+            if (has((int)i))
+                result[schema->name((int)i)] = values[i];
+        return result;
+    }
+};
+
+// === Схема відповіді, спільна для всіх сутностей ===
+struct ResponseFields {
+    enum { Status, Code, OrderData };
+    static const EntitySchema& schema() {
+        static const EntitySchema s{"status", "code", "order_data"};
+        return s;
+    }
+};
+
+// === Елемент пакетного оновлення і його результат ===
+struct EntityUpdate {
+    int entityId;
+    Record data;
+};
+
+struct UpdateResult {
+    int entityId;
+    bool success;
+    string status; // статус з відповіді, "validation_failed", "unchanged", "conflict" або "error"
+};
+
+// === Обмежена черга між етапами конвеєра ===
+template <typename T>
+class BoundedQueue {
+    deque<T> items;
+    size_t capacity;
+    bool closed = false;
+    mutex mtx;
+    condition_variable notEmpty, notFull;
+    // Метрики глибини черги
+    size_t maxDepth = 0;
+    size_t depthSum = 0;
+    size_t pushes = 0;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(max<size_t>(capacity, 1)) {}
+
+    void push(T item) {
+        unique_lock<mutex> lock(mtx);
+        notFull.wait(lock, [&] { return items.size() < capacity; });
+        items.push_back(move(item));
+        maxDepth = max(maxDepth, items.size());
+        depthSum += items.size();
+        ++pushes;
+        notEmpty.notify_one();
+    }
+
+    // false — черга закрита і порожня
+    bool pop(T& item) {
+        unique_lock<mutex> lock(mtx);
+        notEmpty.wait(lock, [&] { return !items.empty() || closed; });
+        if (items.empty())
+            return false;
+        item = move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> lock(mtx);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+    size_t getMaxDepth() {
+        lock_guard<mutex> lock(mtx);
+        return maxDepth;
+    }
+
+    double getAverageDepth() {
+        lock_guard<mutex> lock(mtx);
+        return pushes ? (double)depthSum / pushes : 0.0;
+    }
+
+    void resetMetrics() {
+        lock_guard<mutex> lock(mtx);
+        maxDepth = depthSum = pushes = 0;
+    }
+};
+
+// === Налаштування і метрики конвеєрного режиму ===
+struct PipelineConfig {
+    // Потоків на етап: fetch, validate, build, send, format, after-hook.
+    // Етапи введення-виведення (fetch, send) отримують більше потоків.
+    size_t threads[6] = {4, 1, 1, 4, 1, 1};
+    size_t queueCapacity = 256; // місткість черги кожного потоку етапу
+    size_t maxInFlight = 1024;  // скільки оновлень одночасно перебуває в конвеєрі
+};
+
+struct PipelineStats {
+    double updatesPerSecond = 0;
+    string stageNames[6] = {"fetch", "validate", "build", "send", "format", "after-hook"};
+    size_t maxQueueDepth[6] = {};
+    double averageQueueDepth[6] = {};
+};
+
+// === Вбудоване сховище сутностей із журналом попереднього запису (WAL) ===
+//
+// Таблиці в пам'яті індексуються хешем за id. Кожен запис спершу потрапляє в
+// журнал; окремий потік скидає накопичені записи на диск одним fsync
+// (групова фіксація), а put повертається лише після того, як його запис
+// став надійним. Таблиці в пам'яті змінюються лише після fsync, тому get
+// ніколи не бачить ненадійних даних. При відкритті журнал програється,
+// відновлюючи таблиці, а обірваний хвіст обрізається. Кожен запис журналу має
+// довжину і CRC32, тому хвіст, заповнений нулями чи сміттям, не програється.
+class EntityStore {
+    struct Table {
+        string name;
+        const EntitySchema* schema;
+        unordered_map<int, Record> rows;
+        unordered_map<int, uint64_t> unflushed; // версії, вже додані в журнал, але ще не скинуті (під walMutex)
+        shared_mutex mtx;
+    };
+
+    // Рядок, що чекає на fsync, щоб потрапити в таблицю
+    struct PendingRow {
+        int tableId;
+        int entityId;
+        Record row;
+    };
+
+    string walPath;
+    FILE* wal = nullptr;
+    chrono::microseconds groupCommitWindow;
+    vector<unique_ptr<Table>> tables;
+
+    // Стан групової фіксації
+    mutex walMutex;
+    condition_variable flushed;   // сигнал записувачам: durableSeq зріс
+    condition_variable hasWork;   // сигнал потоку скидання
+    string pending;               // серіалізовані записи, ще не скинуті на диск
+    vector<PendingRow> pendingRows; // ті самі записи для застосування після fsync
+    uint64_t nextSeq = 0;         // номер останнього доданого запису
+    uint64_t durableSeq = 0;      // номер останнього надійно записаного
+    uint64_t syncCount = 0;
+    size_t lastBatchRows = 1;     // розмір попередньої пачки: стільки записувачів очікуємо знову
+    chrono::steady_clock::time_point firstPendingAt; // коли в пачку потрапив перший запис
+    bool walFailed = false;       // запис або fsync не вдався — журнал більше не приймає записів
+    bool stopping = false;
+    thread flusher;
+
+    // Заголовок запису: довжина тіла і CRC32 тіла; тіло — щонайменше таблиця, id, версія і кількість полів
+    static constexpr size_t RECORD_HEADER = 8;
+    static constexpr size_t MIN_RECORD_BODY = 20;
+    static constexpr uint32_t MAX_RECORD_BODY = 64u << 20;
+
+    static void appendU32(string& out, uint32_t v) { out.append((const char*)&v, sizeof(v)); }
+    static void appendU64(string& out, uint64_t v) { out.append((const char*)&v, sizeof(v)); }
+
+    static bool readU32(FILE* f, uint32_t& v) { return fread(&v, sizeof(v), 1, f) == 1; }
+
+    // Послідовне читання тіла запису з буфера; false — тіло закінчилось раніше
+    struct BodyReader {
+        const char* p;
+        const char* end;
+
+        bool u32(uint32_t& v) { return bytes(&v, sizeof(v)); }
+        bool u64(uint64_t& v) { return bytes(&v, sizeof(v)); }
+        bool bytes(void* out, size_t n) {
+            if ((size_t)(end - p) < n)
+                return false;
+            memcpy(out, p, n);
+            p += n;
+            return true;
+        }
+    };
+
+    static uint32_t crc32(const char* data, size_t size) {
+        static const array<uint32_t, 256> table = [] {
+            array<uint32_t, 256> t{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    // Формат запису: [довжина тіла][CRC32 тіла] і тіло: [таблиця][id][версія, 64 біти][кількість полів],
+    // а для кожного поля [індекс][довжина][байти]
+    static void serialize(string& out, uint32_t tableId, int entityId, const Record& row) {
+        uint32_t fields = 0;
+        for (size_t i = 0; i < row.getSchema().size(); ++i)
+            fields += row.has((int)i);
+        size_t header = out.size();
+        out.append(RECORD_HEADER, '\0');
+        appendU32(out, tableId);
+        appendU32(out, (uint32_t)entityId);
+        appendU64(out, row.getVersion());
+        appendU32(out, fields);
+        for (size_t i = 0; i < row.getSchema().size(); ++i) {
+            if (!row.has((int)i))
+                continue;
+            const string& value = row.get((int)i);
+            appendU32(out, (uint32_t)i);
+            appendU32(out, (uint32_t)value.size());
+            out.append(value);
+        }
+        uint32_t length = (uint32_t)(out.size() - header - RECORD_HEADER);
+        uint32_t crc = crc32(out.data() + header + RECORD_HEADER, length);
+        memcpy(&out[header], &length, sizeof(length));
+        memcpy(&out[header + 4], &crc, sizeof(crc));
+    }
+
+    static bool syncFile(FILE* f) {
+        if (fflush(f) != 0)
+            return false;
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+
+    static bool truncateFile(const string& path, long size) {
+#ifdef _WIN32
+        int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+        if (fd < 0)
+            return false;
+        bool ok = _chsize_s(fd, size) == 0;
+        _close(fd);
+#else
+        int fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0)
+            return false;
+        bool ok = ftruncate(fd, size) == 0;
+        ::close(fd);
+#endif
+        return ok;
+    }
+
+    void flushLoop() {
+        string batch;
+        vector<PendingRow> batchRows;
+        unique_lock<mutex> lock(walMutex);
+        while (true) {
+            hasWork.wait(lock, [&] { return !pending.empty() || stopping; });
+            if (pending.empty() && stopping)
+                return;
+            // Вікно групової фіксації: чекаємо інших записувачів, доки пачка не набере
+            // розміру попередньої або не мине вікно від першого запису. Один записувач
+            // (попередня пачка з одного запису) скидається одразу.
+            if (groupCommitWindow.count() > 0) {
+                hasWork.wait_until(lock, firstPendingAt + groupCommitWindow,
+                                   [&] { return stopping || pendingRows.size() >= lastBatchRows; });
+            }
+            batch.swap(pending);
+            batchRows.swap(pendingRows);
+            uint64_t seq = nextSeq;
+            lock.unlock();
+
+            bool ok = fwrite(batch.data(), 1, batch.size(), wal) == batch.size() && syncFile(wal);
+            batch.clear();
+
+            lock.lock();
+            if (!ok) {
+                // Невідомо, яка частина пачки дійшла до диска: записувачі отримують помилку
+                walFailed = true;
+                batchRows.clear();
+                flushed.notify_all();
+                continue;
+            }
+            // Записи стали надійними — тепер їх можна показати читачам, у порядку журналу
+            for (PendingRow& pendingRow : batchRows) {
+                Table& table = *tables[pendingRow.tableId];
+                uint64_t version = pendingRow.row.getVersion();
+                {
+                    unique_lock<shared_mutex> tableLock(table.mtx);
+                    table.rows.insert_or_assign(pendingRow.entityId, move(pendingRow.row));
+                }
+                auto it = table.unflushed.find(pendingRow.entityId);
+                if (it != table.unflushed.end() && it->second == version)
+                    table.unflushed.erase(it);
+            }
+            lastBatchRows = max<size_t>(batchRows.size(), 1);
+            batchRows.clear();
+            durableSeq = seq;
+            ++syncCount;
+            flushed.notify_all();
+        }
+    }
+
+    // Програє журнал до першого неповного або пошкодженого запису (обрив під час запису,
+    // хвіст із нулів): довжина поза межами, CRC32 не збігається або тіло не розбирається.
+    // Повертає зміщення кінця останнього цілого запису або -1, якщо журналу немає.
+    // Цілий запис невідомої таблиці чи поля — не обрив, а інша схема: тоді виняток,
+    // щоб open() не обрізав решту журналу.
+    long recover() {
+        FILE* f = fopen(walPath.c_str(), "rb");
+        if (!f)
+            return -1;
+        long good = 0;
+        string body, schemaError;
+        uint32_t length, crc;
+        while (readU32(f, length) && readU32(f, crc)) {
+            if (length < MIN_RECORD_BODY || length > MAX_RECORD_BODY)
+                break;
+            body.resize(length);
+            if (fread(&body[0], 1, length, f) != length || crc32(body.data(), length) != crc)
+                break;
+
+            BodyReader in{body.data(), body.data() + body.size()};
+            uint32_t tableId = 0, entityId = 0, fields = 0;
+            uint64_t version = 0;
+            if (!(in.u32(tableId) && in.u32(entityId) && in.u64(version) && in.u32(fields)))
+                break;
+            if (tableId >= tables.size()) {
+                schemaError = "таблиця " + to_string(tableId) + " не створена до open()";
+                break;
+            }
+            Table& table = *tables[tableId];
+            Record row(table.schema);
+            bool complete = true;
+            for (uint32_t i = 0; i < fields && complete; ++i) {
+                uint32_t field, valueLength;
+                complete = in.u32(field) && in.u32(valueLength) && valueLength <= (size_t)(in.end - in.p);
+                if (complete && field >= table.schema->size()) {
+                    schemaError = "поле " + to_string(field) + " відсутнє в схемі таблиці " + table.name;
+                    complete = false;
+                }
+                if (!complete)
+                    break;
+                row.set((int)field, string(in.p, valueLength));
+                in.p += valueLength;
+            }
+            if (!complete || in.p != in.end)
+                break;
+            row.setVersion(version);
+            table.rows.insert_or_assign((int)entityId, row);
+            good = ftell(f);
+        }
+        fclose(f);
+        if (!schemaError.empty())
+            throw runtime_error("Журнал " + walPath + " не відповідає схемі сховища (зміщення "
+                                + to_string(good) + "): " + schemaError);
+        return good;
+    }
+
+    // Остання версія рядка з урахуванням записів, що ще чекають на fsync (під walMutex)
+    uint64_t currentVersion(Table& table, int entityId) {
+        auto pendingIt = table.unflushed.find(entityId);
+        if (pendingIt != table.unflushed.end())
+            return pendingIt->second;
+        shared_lock<shared_mutex> tableLock(table.mtx);
+        auto it = table.rows.find(entityId);
+        return it == table.rows.end() ? 0 : it->second.getVersion();
+    }
+
+    bool write(int tableId, int entityId, const Record& row, const uint64_t* expectedVersion) {
+        Table& table = *tables[tableId];
+        unique_lock<mutex> lock(walMutex);
+        if (walFailed)
+            throw runtime_error("Журнал " + walPath + " недоступний після помилки запису");
+        // Порядок у журналі збігається з порядком застосування в пам'яті
+        uint64_t current = currentVersion(table, entityId);
+        if (expectedVersion && *expectedVersion != current) {
+            // Конфліктний запис ще не скинуто: чекаємо на нього, щоб повтор прочитав нову версію
+            flushed.wait(lock, [&] { return !table.unflushed.count(entityId) || walFailed; });
+            return false;
+        }
+
+        if (pendingRows.empty())
+            firstPendingAt = chrono::steady_clock::now();
+        pendingRows.push_back({tableId, entityId, Record(table.schema)});
+        Record& stored = pendingRows.back().row;
+        stored.assign(row);
+        stored.setVersion(current + 1);
+        table.unflushed[entityId] = current + 1;
+        serialize(pending, (uint32_t)tableId, entityId, stored);
+        uint64_t seq = ++nextSeq;
+        hasWork.notify_one();
+
+        flushed.wait(lock, [&] { return durableSeq >= seq || walFailed; });
+        if (durableSeq < seq)
+            throw runtime_error("Не вдалося записати журнал " + walPath);
+        return true;
+    }
+
+public:
+    EntityStore(const string& path, chrono::microseconds window = chrono::microseconds(200))
+        : walPath(path), groupCommitWindow(window) {}
+
+    ~EntityStore() { close(); }
+
+    // Таблиці створюються до open(), щоб відновлення знало їхні схеми
+    int createTable(const string& name, const EntitySchema& schema) {
+        for (size_t i = 0; i < tables.size(); ++i)
+            if (tables[i]->name == name)
+                return (int)i;
+        tables.push_back(make_unique<Table>());
+        tables.back()->name = name;
+        tables.back()->schema = &schema;
+        return (int)tables.size() - 1;
+    }
+
+    void open() {
+        // Обрізаємо обірваний хвіст, інакше нові записи опиняться за ним і загубляться.
+        // Журнал з іншою схемою не обрізається: recover кидає виняток.
+        long good = recover();
+        if (good >= 0 && !truncateFile(walPath, good))
+            throw runtime_error("Не вдалося обрізати журнал " + walPath);
+        wal = fopen(walPath.c_str(), "ab");
+        if (!wal)
+            throw runtime_error("Не вдалося відкрити журнал " + walPath);
+        flusher = thread(&EntityStore::flushLoop, this);
+    }
+
+    void close() {
+        if (!wal)
+            return;
+        {
+            lock_guard<mutex> lock(walMutex);
+            stopping = true;
+            hasWork.notify_one();
+        }
+        flusher.join();
+        fclose(wal);
+        wal = nullptr;
+    }
+
+    bool get(int tableId, int entityId, Record& out) {
+        Table& table = *tables[tableId];
+        shared_lock<shared_mutex> lock(table.mtx);
+        auto it = table.rows.find(entityId);
+        if (it == table.rows.end())
+            return false;
+        out.assign(it->second);
+        return true;
+    }
+
+    // Записує рядок і чекає, поки журнал із ним буде скинуто на диск
+    void put(int tableId, int entityId, const Record& row) {
+        write(tableId, entityId, row, nullptr);
+    }
+
+    // Оптимістичний запис: лише якщо версія рядка досі дорівнює expectedVersion
+    // (0 — рядка ще немає). false — рядок встиг змінити інший записувач.
+    bool compareAndPut(int tableId, int entityId, const Record& row, uint64_t expectedVersion) {
+        return write(tableId, entityId, row, &expectedVersion);
+    }
+
+    size_t rowCount(int tableId) {
+        Table& table = *tables[tableId];
+        shared_lock<shared_mutex> lock(table.mtx);
+        return table.rows.size();
+    }
+
+    uint64_t getSyncCount() {
+        lock_guard<mutex> lock(walMutex);
+        return syncCount;
+    }
+};
+
+// === Трасування кроків шаблонного методу ===
+enum UpdateStep { StepGetEntity, StepValidateData, StepBuildSaveRequest, StepSendRequest,
+                  StepFormatResponse, StepAfterUpdateHook, STEP_COUNT };
+
+inline const char* stepName(int step) {
+    static const char* names[STEP_COUNT] = {"getEntity", "validateData", "buildSaveRequest",
+                                            "sendRequest", "formatResponse", "afterUpdateHook"};
+    return names[step];
+}
+
+// Гістограми кроків одного типу сутності у спільній телеметрії: "<таблиця>.<крок>".
+// Оновлювачі однієї таблиці пишуть в ті самі метрики; з увімкненим трасуванням
+// (telemetry::Telemetry::startTrace) кожен крок також потрапляє у файл траси.
+class StepHistograms {
+    vector<telemetry::Histogram> steps;
+
+public:
+    explicit StepHistograms(const string& entityType) {
+        steps.reserve(STEP_COUNT);
+        for (int s = 0; s < STEP_COUNT; ++s)
+            steps.emplace_back(entityType + "." + stepName(s));
+    }
+
+    const telemetry::Histogram& operator[](int step) const { return steps[step]; }
+};
+
+// === Абстрактний базовий клас ===
+// Рядок журналу оновлювача: після setVerbose(false) виводиться лише на рівні Debug
+#define UPDATER_LOG TLOG_AT(logLevel())
+
+class EntityUpdater {
+public:
+    virtual ~EntityUpdater() = default;
+
+    // --- Шаблонний метод ---
+    void update(int entityId, const Record& newData) {
+        static const telemetry::Counter completed("updater.completed");
+        static const telemetry::Counter conflicts("updater.conflict_retry");
+        for (int attempt = 0; ; ++attempt) {
+            entity.clear();
+            {
+                telemetry::Span span(stepTimes[StepGetEntity]);
+                getEntity(entityId, entity);
+            }
+            data.assign(newData);
+
+            bool valid;
+            {
+                telemetry::Span span(stepTimes[StepValidateData]);
+                valid = validateData(entity, data);
+            }
+            if (!valid) {
+                onValidationFailed(entity, data);
+                UPDATER_LOG << "Validation failed. Update aborted.\n";
+                return;
+            }
+
+            if (!keepChangedFields(entity, data)) {
+                UPDATER_LOG << "No changes. Update skipped.\n\n";
+                return;
+            }
+
+            request.clear();
+            {
+                telemetry::Span span(stepTimes[StepBuildSaveRequest]);
+                buildSaveRequest(entity, data, request);
+            }
+            request.setVersion(entity.getVersion());
+            response.clear();
+            {
+                telemetry::Span span(stepTimes[StepSendRequest]);
+                sendRequest(request, response);
+            }
+
+            // Сутність змінив інший записувач — перечитуємо і пробуємо знову
+            if (!isConflict(response))
+                break;
+            if (attempt == MAX_CONFLICT_RETRIES) {
+                UPDATER_LOG << "Version conflict. Update aborted.\n";
+                return;
+            }
+            ++conflictRetries;
+            conflicts.add();
+            UPDATER_LOG << "Version conflict. Retrying...\n";
+        }
+        if (!isSucceeded(response)) {
+            UPDATER_LOG << "Save failed. Update aborted.\n";
+            return;
+        }
+
+        finalResponse.clear();
+        {
+            telemetry::Span span(stepTimes[StepFormatResponse]);
+            formatResponse(response, entity, finalResponse);
+        }
+
+        {
+            telemetry::Span span(stepTimes[StepAfterUpdateHook]);
+            afterUpdateHook(entity, finalResponse);
+        }
+        completed.add();
+        UPDATER_LOG << "Update complete.\n\n";
+    }
+
+    // --- Пакетний шаблонний метод ---
+    // Одне масове отримання, валідація і формування запитів проходом по масивах,
+    // надсилання пачками до maxBatchSize запитів. results[i] відповідає updates[i].
+    // Повтор id починає новий сегмент: його сутність читається вже після записів
+    // попереднього, тож результат такий самий, як у послідовних update.
+    void updateMany(const vector<EntityUpdate>& updates, vector<UpdateResult>& results, size_t maxBatchSize = 1000) {
+        size_t n = updates.size();
+        results.clear();
+        results.reserve(n);
+        for (size_t begin = 0; begin < n; ) {
+            batchSeen.clear();
+            size_t end = begin;
+            while (end < n && batchSeen.insert(updates[end].entityId).second)
+                ++end;
+            updateSegment(updates.data() + begin, end - begin, results, maxBatchSize);
+            begin = end;
+        }
+        size_t succeeded = 0;
+        for (const UpdateResult& r : results)
+            succeeded += r.success;
+        UPDATER_LOG << "Batch update complete: " << succeeded << "/" << n << " updated.\n\n";
+    }
+
+    // --- Конвеєрний режим ---
+    // Кожен крок шаблонного методу виконується власним пулом потоків, етапи з'єднані
+    // обмеженими чергами. Оновлення розподіляються між потоками етапу за entityId;
+    // наступне оновлення тієї самої сутності входить у конвеєр лише після того, як
+    // попереднє пройшло всі етапи.
+    // Потоки етапів створюються при першому виклику і перевикористовуються наступними,
+    // доки не зміняться налаштування. Виняток кроку завершує лише своє оновлення
+    // зі статусом "error". Кроки підкласу мають бути потокобезпечними; журнал варто
+    // вимкнути (setVerbose).
+    PipelineStats updatePipelined(const vector<EntityUpdate>& updates, vector<UpdateResult>& results,
+                                  const PipelineConfig& config = PipelineConfig()) {
+        lock_guard<mutex> lock(pipelineMutex);
+        results.assign(updates.size(), UpdateResult{0, false, ""});
+        if (!pipeline || !pipeline->matches(config))
+            pipeline = make_unique<Pipeline>(*this, config);
+        pipeline->resetMetrics();
+
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < updates.size(); ++i) {
+            PipelineItem* item = pipeline->acquire();
+            item->update = &updates[i];
+            item->result = &results[i];
+            item->entityId = updates[i].entityId;
+            pipeline->submit(item);
+        }
+        pipeline->drain();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        PipelineStats stats;
+        stats.updatesPerSecond = seconds > 0 ? updates.size() / seconds : 0;
+        pipeline->fillStats(stats);
+        return stats;
+    }
+
+    // Сумісність: оновлення з map; невідомі поля ігноруються
+    void update(int entityId, const map<string, string>& newData) {
+        Record record(&entitySchema);
+        for (auto& field : newData)
+            record.set(field.first, field.second);
+        update(entityId, record);
+    }
+
+    // Порожній запис для нових даних цієї сутності
+    Record makeRecord() const { return Record(&entitySchema); }
+
+    void setVerbose(bool v) { verbose = v; }
+
+    // Скільки разів update повторювався через конфлікт версій
+    size_t getConflictRetries() const { return conflictRetries; }
+
+    // Підключає сховище: кроки читатимуть і записуватимуть сутності в нього
+    void attachStore(EntityStore* s) {
+        store = s;
+        storeTable = s->createTable(tableName, entitySchema);
+    }
+
+protected:
+    EntityUpdater(const EntitySchema& entitySchema, const EntitySchema& requestSchema, const string& tableName)
+        : entitySchema(entitySchema), requestSchema(requestSchema), tableName(tableName),
+          stepTimes(tableName),
+          entity(&entitySchema), data(&entitySchema), request(&requestSchema),
+          response(&ResponseFields::schema()), finalResponse(&ResponseFields::schema()) {}
+
+    telemetry::LogLevel logLevel() const { return verbose ? telemetry::LogLevel::Info : telemetry::LogLevel::Debug; }
+
+    // false — сховище не підключене або сутності в ньому немає
+    bool loadFromStore(int entityId, Record& entity) {
+        return store && store->get(storeTable, entityId, entity);
+    }
+
+    bool hasStore() const { return store != nullptr; }
+
+    // Запис із перевіркою версії; false — конфлікт із іншим записувачем
+    bool saveToStore(int entityId, const Record& entity, uint64_t expectedVersion) {
+        return !store || store->compareAndPut(storeTable, entityId, entity, expectedVersion);
+    }
+
+    static void markConflict(Record& response) {
+        response.set(ResponseFields::Status, "conflict");
+    }
+
+    static void markError(Record& response) {
+        response.set(ResponseFields::Status, "error");
+    }
+
+    // Відповідь сховища або підсумкова: успіх — будь-який статус, крім конфлікту і помилки
+    static bool isSucceeded(const Record& response) {
+        if (!response.has(ResponseFields::Status))
+            return false;
+        const string& status = response.get(ResponseFields::Status);
+        return status != "conflict" && status != "error";
+    }
+
+    // === Абстрактні методи (кроки алгоритму) ===
+    virtual void getEntity(int entityId, Record& entity) = 0;
+    virtual bool validateData(Record& entity, Record& newData) = 0;
+    virtual void buildSaveRequest(Record& entity, Record& newData, Record& request) = 0;
+    virtual void sendRequest(Record& request, Record& response) = 0;
+
+    // === Пакетні кроки (за замовчуванням — поелементно) ===
+    virtual void getEntities(const int* ids, Record* entities, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+            getEntity(ids[i], entities[i]);
+    }
+
+    virtual void sendRequests(Record* requests, Record* responses, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+            sendRequest(requests[i], responses[i]);
+    }
+
+    // === Методи за замовчуванням ===
+    // Підсумкова відповідь повторює результат відповіді сховища
+    virtual void formatResponse(Record& response, Record& entity, Record& result) {
+        bool ok = isSucceeded(response);
+        result.set(ResponseFields::Status, ok ? "success" : "error");
+        result.set(ResponseFields::Code, ok ? "200" : "500");
+    }
+
+    // === Хуки (точки розширення) ===
+    virtual void onValidationFailed(Record& entity, Record& newData) {}
+    virtual void afterUpdateHook(Record& entity, Record& response) {}
+
+private:
+    static const int MAX_CONFLICT_RETRIES = 5;
+
+    static bool isConflict(const Record& response) {
+        return response.get(ResponseFields::Status) == "conflict";
+    }
+
+    // Сегмент пакета з різними id
+    void updateSegment(const EntityUpdate* updates, size_t n, vector<UpdateResult>& results, size_t maxBatchSize) {
+        size_t first = results.size(); // результат елемента i — results[first + i]
+        ensureRecords(batchEntities, n, &entitySchema);
+        ensureRecords(batchData, n, &entitySchema);
+        ensureRecords(batchRequests, n, &requestSchema);
+        ensureRecords(batchResponses, n, &ResponseFields::schema());
+
+        // 1. Масове отримання сутностей
+        batchIds.clear();
+        for (size_t i = 0; i < n; ++i)
+            batchIds.push_back(updates[i].entityId);
+        for (size_t i = 0; i < n; ++i)
+            batchEntities[i].clear();
+        {
+            telemetry::Span span(stepTimes[StepGetEntity]);
+            getEntities(batchIds.data(), batchEntities.data(), n);
+        }
+
+        // 2. Валідація і формування запитів; валідні запити ущільнюються на початок масиву
+        batchValid.clear();
+        for (size_t i = 0; i < n; ++i) {
+            batchData[i].assign(updates[i].data);
+            if (!validateData(batchEntities[i], batchData[i])) {
+                onValidationFailed(batchEntities[i], batchData[i]);
+                results.push_back({updates[i].entityId, false, "validation_failed"});
+                continue;
+            }
+            if (!keepChangedFields(batchEntities[i], batchData[i])) {
+                results.push_back({updates[i].entityId, true, "unchanged"});
+                continue;
+            }
+            Record& request = batchRequests[batchValid.size()];
+            request.clear();
+            buildSaveRequest(batchEntities[i], batchData[i], request);
+            request.setVersion(batchEntities[i].getVersion());
+            batchValid.push_back(i);
+            results.push_back({updates[i].entityId, false, ""}); // успіх визначить відповідь
+        }
+
+        // 3. Надсилання пачками
+        size_t valid = batchValid.size();
+        size_t step = max<size_t>(maxBatchSize, 1);
+        for (size_t i = 0; i < valid; ++i)
+            batchResponses[i].clear();
+        for (size_t begin = 0; begin < valid; begin += step) {
+            telemetry::Span span(stepTimes[StepSendRequest]);
+            size_t count = min(step, valid - begin);
+            try {
+                sendRequests(batchRequests.data() + begin, batchResponses.data() + begin, count);
+            } catch (const exception& e) {
+                // Запити пачки, що не отримали відповіді, вважаються невдалими
+                UPDATER_LOG << "Batch send failed: " << e.what() << "\n";
+                for (size_t k = begin; k < begin + count; ++k)
+                    if (!batchResponses[k].has(ResponseFields::Status))
+                        markError(batchResponses[k]);
+            }
+        }
+
+        // 4. Відповіді і хуки для кожного елемента; успіх — за статусом відповіді
+        for (size_t k = 0; k < valid; ++k) {
+            size_t i = batchValid[k];
+            if (isConflict(batchResponses[k])) {
+                results[first + i] = {updates[i].entityId, false, "conflict"};
+                continue;
+            }
+            if (!isSucceeded(batchResponses[k])) {
+                results[first + i] = {updates[i].entityId, false, "error"};
+                continue;
+            }
+            finalResponse.clear();
+            formatResponse(batchResponses[k], batchEntities[i], finalResponse);
+            afterUpdateHook(batchEntities[i], finalResponse);
+            results[first + i] = {updates[i].entityId, isSucceeded(finalResponse),
+                                  finalResponse.get(ResponseFields::Status)};
+        }
+    }
+
+    // Залишає в newData лише поля, що відрізняються від знімка сутності.
+    // false — змін немає і оновлення можна пропустити.
+    static bool keepChangedFields(const Record& entity, Record& newData) {
+        bool changed = false;
+        for (int i = 0; i < (int)newData.getSchema().size(); ++i) {
+            if (!newData.has(i))
+                continue;
+            if (entity.has(i) && entity.get(i) == newData.get(i))
+                newData.erase(i);
+            else
+                changed = true;
+        }
+        return changed;
+    }
+
+    // Стан одного оновлення, що рухається конвеєром
+    struct PipelineItem {
+        const EntityUpdate* update = nullptr;
+        UpdateResult* result = nullptr;
+        int entityId = 0;
+        bool active = false; // false — оновлення завершилось раніше (валідація, без змін, конфлікт)
+        Record entity, data, request, response, finalResponse;
+
+        PipelineItem(const EntitySchema* entitySchema, const EntitySchema* requestSchema)
+            : entity(entitySchema), data(entitySchema), request(requestSchema),
+              response(&ResponseFields::schema()), finalResponse(&ResponseFields::schema()) {}
+    };
+
+    // Потоки етапів конвеєра з їхніми чергами і пулом робочих записів
+    class Pipeline {
+    public:
+        static const size_t STAGES = 6;
+
+        Pipeline(EntityUpdater& owner, const PipelineConfig& config)
+            : config(config), slots(max<size_t>(config.maxInFlight, 1)), freeItems(slots) {
+            // Кількість робочих записів обмежує число оновлень у конвеєрі
+            for (size_t i = 0; i < slots; ++i) {
+                storage.push_back(make_unique<PipelineItem>(&owner.entitySchema, &owner.requestSchema));
+                freeItems.push(storage.back().get());
+            }
+            // Черги: по одній на кожен потік кожного етапу
+            for (size_t s = 0; s < STAGES; ++s)
+                for (size_t w = 0; w < max<size_t>(config.threads[s], 1); ++w)
+                    queues[s].push_back(make_unique<BoundedQueue<PipelineItem*>>(config.queueCapacity));
+            for (size_t s = 0; s < STAGES; ++s) {
+                for (auto& queue : queues[s]) {
+                    BoundedQueue<PipelineItem*>* in = queue.get();
+                    workers[s].emplace_back([this, &owner, s, in] {
+                        PipelineItem* item = nullptr;
+                        while (in->pop(item)) {
+                            owner.runPipelineStep(s, item);
+                            if (s + 1 < STAGES) {
+                                route(s + 1, item);
+                            } else {
+                                release(item->entityId);
+                                freeItems.push(item);
+                            }
+                        }
+                    });
+                }
+            }
+        }
+
+        // Закриваємо етапи по черзі: кожен завершується, коли попередній уже все передав
+        ~Pipeline() {
+            for (size_t s = 0; s < STAGES; ++s) {
+                for (auto& queue : queues[s])
+                    queue->close();
+                for (auto& t : workers[s])
+                    t.join();
+            }
+        }
+
+        bool matches(const PipelineConfig& other) const {
+            return equal(begin(config.threads), end(config.threads), begin(other.threads))
+                && config.queueCapacity == other.queueCapacity && config.maxInFlight == other.maxInFlight;
+        }
+
+        PipelineItem* acquire() {
+            PipelineItem* item = nullptr;
+            freeItems.pop(item);
+            return item;
+        }
+
+        // Оновлення сутності, що вже в конвеєрі, чекає, доки попереднє пройде всі етапи:
+        // інакше fetch прочитав би сутність до запису попереднього оновлення
+        void submit(PipelineItem* item) {
+            {
+                unique_lock<mutex> lock(busyMutex);
+                idReleased.wait(lock, [&] { return busyIds.count(item->entityId) == 0; });
+                busyIds.insert(item->entityId);
+            }
+            route(0, item);
+        }
+
+        // Чекає, доки всі робочі записи повернуться з останнього етапу
+        void drain() {
+            vector<PipelineItem*> items(slots);
+            for (PipelineItem*& item : items)
+                freeItems.pop(item);
+            for (PipelineItem* item : items)
+                freeItems.push(item);
+        }
+
+        void resetMetrics() {
+            for (auto& stageQueues : queues)
+                for (auto& queue : stageQueues)
+                    queue->resetMetrics();
+        }
+
+        void fillStats(PipelineStats& stats) {
+            for (size_t s = 0; s < STAGES; ++s) {
+                double sum = 0;
+                for (auto& queue : queues[s]) {
+                    stats.maxQueueDepth[s] = max(stats.maxQueueDepth[s], queue->getMaxDepth());
+                    sum += queue->getAverageDepth();
+                }
+                stats.averageQueueDepth[s] = sum / queues[s].size();
+            }
+        }
+
+    private:
+        void release(int entityId) {
+            lock_guard<mutex> lock(busyMutex);
+            busyIds.erase(entityId);
+            idReleased.notify_all();
+        }
+
+        void route(size_t stage, PipelineItem* item) {
+            auto& stageQueues = queues[stage];
+            stageQueues[(unsigned)item->entityId % stageQueues.size()]->push(item);
+        }
+
+        PipelineConfig config;
+        size_t slots;
+        vector<unique_ptr<PipelineItem>> storage;
+        BoundedQueue<PipelineItem*> freeItems;
+        vector<unique_ptr<BoundedQueue<PipelineItem*>>> queues[STAGES];
+        vector<thread> workers[STAGES];
+        unordered_set<int> busyIds; // id оновлень, що зараз у конвеєрі
+        mutex busyMutex;
+        condition_variable idReleased;
+    };
+
+    // Один крок конвеєра для одного оновлення; виняток завершує оновлення з помилкою
+    void runPipelineStep(size_t stage, PipelineItem* item) {
+        telemetry::Span span(stepTimes[(int)stage]);
+        try {
+            switch (stage) {
+            case 0:
+                item->active = true;
+                item->entity.clear();
+                getEntity(item->entityId, item->entity);
+                item->data.assign(item->update->data);
+                break;
+            case 1:
+                item->active = validateData(item->entity, item->data);
+                if (!item->active) {
+                    onValidationFailed(item->entity, item->data);
+                    *item->result = {item->entityId, false, "validation_failed"};
+                } else if (!keepChangedFields(item->entity, item->data)) {
+                    item->active = false;
+                    *item->result = {item->entityId, true, "unchanged"};
+                }
+                break;
+            case 2:
+                if (item->active) {
+                    item->request.clear();
+                    buildSaveRequest(item->entity, item->data, item->request);
+                    item->request.setVersion(item->entity.getVersion());
+                }
+                break;
+            case 3:
+                if (item->active) {
+                    item->response.clear();
+                    sendRequest(item->request, item->response);
+                    if (!isSucceeded(item->response)) {
+                        item->active = false;
+                        *item->result = {item->entityId, false, isConflict(item->response) ? "conflict" : "error"};
+                    }
+                }
+                break;
+            case 4:
+                if (item->active) {
+                    item->finalResponse.clear();
+                    formatResponse(item->response, item->entity, item->finalResponse);
+                }
+                break;
+            case 5:
+                if (item->active) {
+                    afterUpdateHook(item->entity, item->finalResponse);
+                    *item->result = {item->entityId, isSucceeded(item->finalResponse),
+                                     item->finalResponse.get(ResponseFields::Status)};
+                }
+                break;
+            }
+        } catch (const exception& e) {
+            // Запис іде далі неактивним, щоб повернутися в пул з останнього етапу
+            if (item->active) {
+                item->active = false;
+                *item->result = {item->entityId, false, "error"};
+                UPDATER_LOG << "Pipeline step " << stage << " failed for ID " << item->entityId << ": " << e.what() << "\n";
+            }
+        }
+    }
+
+    static void ensureRecords(vector<Record>& records, size_t count, const EntitySchema* schema) {
+        while (records.size() < count)
+            records.emplace_back(schema);
+    }
+
+    const EntitySchema& entitySchema;
+    const EntitySchema& requestSchema;
+    string tableName;
+    StepHistograms stepTimes;
+    EntityStore* store = nullptr;
+    int storeTable = -1;
+    size_t conflictRetries = 0;
+    // Робочі записи перевикористовуються між викликами update / updateMany
+    Record entity, data, request, response, finalResponse;
+    vector<int> batchIds;
+    unordered_set<int> batchSeen;
+    vector<size_t> batchValid;
+    vector<Record> batchEntities, batchData, batchRequests, batchResponses;
+    bool verbose = true;
+    // Останнім членом: потоки етапів зупиняються раніше, ніж звільняються інші поля
+    mutex pipelineMutex;
+    unique_ptr<Pipeline> pipeline;
+};
+
+
+// === Реалізація для Product ===
+struct ProductFields {
+    enum { Id, Name, Price };
+    static const EntitySchema& schema() {
+        static const EntitySchema s{"id", "name", "price"};
+        return s;
+    }
+};
+
+struct ProductRequestFields {
+    enum { ProductId, Data };
+    static const EntitySchema& schema() {
+        static const EntitySchema s{"product_id", "data"};
+        return s;
+    }
+};
+
+class ProductUpdater : public EntityUpdater {
+public:
+    ProductUpdater() : EntityUpdater(ProductFields::schema(), ProductRequestFields::schema(), "product") {}
+
+private:
+    // Демонстраційні дані, якщо сховище не підключене
+    static void fillDefaults(int entityId, Record& entity) {
+        entity.set(ProductFields::Id, to_string(entityId));
+        entity.set(ProductFields::Name, "Laptop");
+    }
+
+protected:
+    void getEntity(int entityId, Record& entity) override {
+        UPDATER_LOG << "[Product] Отримання продукту ID: " << entityId << endl;
+        if (!loadFromStore(entityId, entity))
+            fillDefaults(entityId, entity);
+    }
+
+    bool validateData(Record& entity, Record& newData) override {
+        UPDATER_LOG << "[Product] Перевірка валідності даних...\n";
+        const string& price = newData.get(ProductFields::Price);
+        if (price.empty() || stoi(price) <= 0)
+            return false;
+        return true;
+    }
+
+    void onValidationFailed(Record& entity, Record& newData) override {
+        UPDATER_LOG << "[Product] Валідація не пройдена — надсилаємо сповіщення адміністратору в месенджер.\n";
+    }
+
+    void buildSaveRequest(Record& entity, Record& newData, Record& request) override {
+        UPDATER_LOG << "[Product] Формування запиту для збереження...\n";
+        request.set(ProductRequestFields::ProductId, entity.get(ProductFields::Id));
+        // newData містить лише змінені поля — незмінені в запит не потрапляють
+        if (newData.has(ProductFields::Price))
+            request.set(ProductRequestFields::Data, newData.get(ProductFields::Price));
+    }
+
+    void sendRequest(Record& request, Record& response) override {
+        UPDATER_LOG << "[Product] Надсилання запиту...\n";
+        if (hasStore()) {
+            int id = stoi(request.get(ProductRequestFields::ProductId));
+            Record row(&ProductFields::schema());
+            if (!loadFromStore(id, row))
+                fillDefaults(id, row);
+            if (request.has(ProductRequestFields::Data))
+                row.set(ProductFields::Price, request.get(ProductRequestFields::Data));
+            if (!saveToStore(id, row, request.getVersion())) {
+                markConflict(response);
+                return;
+            }
+        }
+        response.set(ResponseFields::Status, "ok");
+    }
+};
+
+
+// === Реалізація для User ===
+struct UserFields {
+    enum { Id, Name, Email };
+    static const EntitySchema& schema() {
+        static const EntitySchema s{"id", "name", "email"};
+        return s;
+    }
+};
+
+struct UserRequestFields {
+    enum { UserId, UpdateName };
+    static const EntitySchema& schema() {
+        static const EntitySchema s{"user_id", "update_name"};
+        return s;
+    }
+};
+
+class UserUpdater : public EntityUpdater {
+public:
+    UserUpdater() : EntityUpdater(UserFields::schema(), UserRequestFields::schema(), "user") {}
+
+private:
+    // Демонстраційні дані, якщо сховище не підключене
+    static void fillDefaults(int entityId, Record& entity) {
+        entity.set(UserFields::Id, to_string(entityId));
+        entity.set(UserFields::Name, "Danylo");
+        entity.set(UserFields::Email, "user@mail.com");
+    }
+
+protected:
+    void getEntity(int entityId, Record& entity) override {
+        UPDATER_LOG << "[User] Отримання користувача ID: " << entityId << endl;
+        if (!loadFromStore(entityId, entity))
+            fillDefaults(entityId, entity);
+    }
+
+    bool validateData(Record& entity, Record& newData) override {
+        UPDATER_LOG << "[User] Перевірка даних...\n";
+        if (newData.has(UserFields::Email)) {
+            UPDATER_LOG << "[User] Поле 'email' заборонено змінювати! Видаляємо його.\n";
+            newData.erase(UserFields::Email);
+        }
+        return true;
+    }
+
+    void buildSaveRequest(Record& entity, Record& newData, Record& request) override {
+        UPDATER_LOG << "[User] Формування запиту на оновлення користувача...\n";
+        request.set(UserRequestFields::UserId, entity.get(UserFields::Id));
+        if (newData.has(UserFields::Name))
+            request.set(UserRequestFields::UpdateName, newData.get(UserFields::Name));
+    }
+
+    void sendRequest(Record& request, Record& response) override {
+        UPDATER_LOG << "[User] Надсилання запиту...\n";
+        if (hasStore()) {
+            int id = stoi(request.get(UserRequestFields::UserId));
+            Record row(&UserFields::schema());
+            if (!loadFromStore(id, row))
+                fillDefaults(id, row);
+            if (request.has(UserRequestFields::UpdateName))
+                row.set(UserFields::Name, request.get(UserRequestFields::UpdateName));
+            if (!saveToStore(id, row, request.getVersion())) {
+                markConflict(response);
+                return;
+            }
+        }
+        response.set(ResponseFields::Status, "updated");
+    }
+};
+
+
+// === Реалізація для Order ===
+struct OrderFields {
+    enum { Id, Item, Total, Status };
+    static const EntitySchema& schema() {
+        static const EntitySchema s{"id", "item", "total", "status"};
+        return s;
+    }
+};
+
+struct OrderRequestFields {
+    enum { OrderId, Status, Total };
+    static const EntitySchema& schema() {
+        static const EntitySchema s{"order_id", "status", "total"};
+        return s;
+    }
+};
+
+class OrderUpdater : public EntityUpdater {
+public:
+    OrderUpdater() : EntityUpdater(OrderFields::schema(), OrderRequestFields::schema(), "order") {}
+
+    // Імітація віддаленого сервісу замовлень: кожен виклик getEntity / sendRequest
+    // і кожен масовий виклик чекає один обмін із сервером
+    void setRoundTrip(chrono::microseconds rtt) { roundTrip = rtt; }
+
+private:
+    chrono::microseconds roundTrip{0};
+
+    void waitRoundTrip() const {
+        if (roundTrip.count() > 0)
+            this_thread::sleep_for(roundTrip);
+    }
+
+    // Демонстраційні дані, якщо сховище не підключене
+    static void fillDefaults(int entityId, Record& entity) {
+        entity.set(OrderFields::Id, to_string(entityId));
+        entity.set(OrderFields::Item, "Laptop");
+        entity.set(OrderFields::Total, "1500");
+    }
+
+    void saveOrder(Record& request, Record& response) {
+        if (hasStore()) {
+            int id = stoi(request.get(OrderRequestFields::OrderId));
+            Record row(&OrderFields::schema());
+            if (!loadFromStore(id, row))
+                fillDefaults(id, row);
+            // Зливаємо лише поля, присутні в запиті
+            if (request.has(OrderRequestFields::Status))
+                row.set(OrderFields::Status, request.get(OrderRequestFields::Status));
+            if (request.has(OrderRequestFields::Total))
+                row.set(OrderFields::Total, request.get(OrderRequestFields::Total));
+            if (!saveToStore(id, row, request.getVersion())) {
+                markConflict(response);
+                return;
+            }
+        }
+        response.set(ResponseFields::Status, "success");
+    }
+
+protected:
+    void getEntity(int entityId, Record& entity) override {
+        UPDATER_LOG << "[Order] Отримання замовлення ID: " << entityId << endl;
+        waitRoundTrip();
+        if (!loadFromStore(entityId, entity))
+            fillDefaults(entityId, entity);
+    }
+
+    bool validateData(Record& entity, Record& newData) override {
+        UPDATER_LOG << "[Order] Валідація даних...\n";
+        return true;
+    }
+
+    void buildSaveRequest(Record& entity, Record& newData, Record& request) override {
+        UPDATER_LOG << "[Order] Формування запиту для оновлення замовлення...\n";
+        request.set(OrderRequestFields::OrderId, entity.get(OrderFields::Id));
+        if (newData.has(OrderFields::Status))
+            request.set(OrderRequestFields::Status, newData.get(OrderFields::Status));
+        if (newData.has(OrderFields::Total))
+            request.set(OrderRequestFields::Total, newData.get(OrderFields::Total));
+    }
+
+    void sendRequest(Record& request, Record& response) override {
+        UPDATER_LOG << "[Order] Надсилання запиту...\n";
+        waitRoundTrip();
+        saveOrder(request, response);
+    }
+
+    // Масове отримання замовлень одним запитом
+    void getEntities(const int* ids, Record* entities, size_t count) override {
+        UPDATER_LOG << "[Order] Масове отримання " << count << " замовлень\n";
+        waitRoundTrip();
+        for (size_t i = 0; i < count; ++i) {
+            if (!loadFromStore(ids[i], entities[i]))
+                fillDefaults(ids[i], entities[i]);
+        }
+    }
+
+    // Один масовий запит на пачку замовлень
+    void sendRequests(Record* requests, Record* responses, size_t count) override {
+        UPDATER_LOG << "[Order] Надсилання пачки з " << count << " запитів...\n";
+        waitRoundTrip();
+        for (size_t i = 0; i < count; ++i) {
+            saveOrder(requests[i], responses[i]);
+        }
+    }
+
+    void formatResponse(Record& response, Record& entity, Record& result) override {
+        UPDATER_LOG << "[Order] Формування розширеної відповіді...\n";
+        if (!isSucceeded(response)) {
+            EntityUpdater::formatResponse(response, entity, result);
+            return;
+        }
+        string orderInfo = "{id: " + entity.get(OrderFields::Id) + ", item: " + entity.get(OrderFields::Item)
+                         + ", total: " + entity.get(OrderFields::Total) + "}";
+        result.set(ResponseFields::Status, "success");
+        result.set(ResponseFields::Code, "200");
+        result.set(ResponseFields::OrderData, orderInfo);
+    }
+};
+
+
+// === Вимірювання: оновлень за секунду і виділень пам'яті на оновлення ===
+void benchmark(const string& name, EntityUpdater& updater, const Record& data, int iterations = 200000) {
+    updater.setVerbose(false);
+    updater.update(1, data); // прогрів робочих записів
+
+    size_t allocationsBefore = alloc_counter::allocationCount();
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        updater.update(i, data);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t allocations = alloc_counter::allocationCount() - allocationsBefore;
+
+    telemetry::flush();
+    cout << name << ": " << (size_t)(iterations / seconds) << " оновлень/с, "
+         << (double)allocations / iterations << " виділень на оновлення\n";
+    updater.setVerbose(true);
+}
+
+
+// === Клієнтський код ===
+int main() {
+#ifdef _WIN32
+    SetConsoleOutputCP(65001);
+#endif
+    cout << "\n---Оновлення продукту ---\n";
+    ProductUpdater product;
+    product.update(1, {{"price", "-10"}});
+
+    // Журнал оновлювачів виводиться у фоні — вивантажуємо його перед прямим виводом
+    telemetry::flush();
+    cout << "\n---Оновлення користувача ---\n";
+    UserUpdater user;
+    user.update(2, {{"name", "Ivan"}, {"email", "new@mail.com"}});
+
+    telemetry::flush();
+    cout << "\n---Оновлення замовлення ---\n";
+    OrderUpdater order;
+    order.update(3, {{"status", "shipped"}});
+
+    telemetry::flush();
+    cout << "\n---Пакетне оновлення продуктів ---\n";
+    vector<EntityUpdate> productUpdates;
+    for (int id = 10; id < 13; ++id) {
+        Record r = product.makeRecord();
+        r.set(ProductFields::Price, id == 11 ? "0" : "999");
+        productUpdates.push_back({id, r});
+    }
+    vector<UpdateResult> results;
+    product.updateMany(productUpdates, results);
+    telemetry::flush();
+    for (auto& r : results)
+        cout << "  ID " << r.entityId << ": " << (r.success ? "OK" : "помилка") << " (" << r.status << ")\n";
+
+    telemetry::flush();
+    cout << "\n---Продуктивність ---\n";
+    // Без вимірювання кроків: відрізки телеметрії коштують лише одного читання прапорця
+    bool timingWasOn = telemetry::timing();
+    telemetry::setTiming(false);
+    Record productData = product.makeRecord();
+    productData.set(ProductFields::Price, "1200");
+    benchmark("ProductUpdater", product, productData);
+
+    Record userData = user.makeRecord();
+    userData.set(UserFields::Name, "Ivan");
+    userData.set(UserFields::Email, "new@mail.com");
+    benchmark("UserUpdater", user, userData);
+
+    Record orderData = order.makeRecord();
+    orderData.set(OrderFields::Status, "shipped");
+    benchmark("OrderUpdater", order, orderData);
+
+    // Пакетний режим для великого імпорту замовлень
+    vector<EntityUpdate> orderUpdates;
+    for (int id = 0; id < 100000; ++id)
+        orderUpdates.push_back({id, orderData});
+    order.setVerbose(false);
+    order.updateMany(orderUpdates, results); // прогрів
+    size_t allocationsBefore = alloc_counter::allocationCount();
+    auto start = chrono::steady_clock::now();
+    order.updateMany(orderUpdates, results);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "OrderUpdater::updateMany: " << (size_t)(orderUpdates.size() / seconds) << " оновлень/с, "
+         << (double)(alloc_counter::allocationCount() - allocationsBefore) / orderUpdates.size()
+         << " виділень на оновлення\n";
+
+    // Без затримки пакет і конвеєр лише додають роботу; виграють вони тоді, коли кожен
+    // виклик сервісу чекає обмін: update робить два обміни на оновлення, updateMany —
+    // два на пачку, а конвеєр перекриває обміни потоками етапів fetch і send
+    OrderUpdater remote;
+    remote.setVerbose(false);
+    remote.setRoundTrip(chrono::microseconds(200));
+    const vector<EntityUpdate> remoteUpdates(orderUpdates.begin(), orderUpdates.begin() + 2000);
+    auto remoteRate = [&](auto run) {
+        auto runStart = chrono::steady_clock::now();
+        run();
+        return (size_t)(remoteUpdates.size() / chrono::duration<double>(chrono::steady_clock::now() - runStart).count());
+    };
+    cout << "Сервіс із затримкою 200 мкс на обмін: update "
+         << remoteRate([&] { for (const EntityUpdate& u : remoteUpdates) remote.update(u.entityId, u.data); })
+         << " оновлень/с, updateMany "
+         << remoteRate([&] { remote.updateMany(remoteUpdates, results); }) << " оновлень/с, updatePipelined "
+         << remoteRate([&] { remote.updatePipelined(remoteUpdates, results); }) << " оновлень/с\n";
+
+    // Конвеєрний режим: кроки на окремих потоках, з'єднані обмеженими чергами
+    PipelineStats stats = order.updatePipelined(orderUpdates, results);
+    cout << "OrderUpdater::updatePipelined: " << (size_t)stats.updatesPerSecond << " оновлень/с\n";
+    for (int s = 0; s < 6; ++s)
+        cout << "  " << stats.stageNames[s] << ": макс. глибина черги " << stats.maxQueueDepth[s]
+             << ", середня " << stats.averageQueueDepth[s] << "\n";
+    stats = order.updatePipelined(orderUpdates, results);
+    cout << "Повторний виклик на тих самих потоках етапів: " << (size_t)stats.updatesPerSecond << " оновлень/с\n";
+
+    // Виняток кроку (stoi у перевірці ціни) завершує лише своє оновлення
+    Record badPrice = product.makeRecord();
+    badPrice.set(ProductFields::Price, "дорого");
+    product.setVerbose(false);
+    product.updatePipelined({{20, productData}, {21, badPrice}, {22, productData}}, results);
+    cout << "Конвеєр із некоректною ціною:";
+    for (const UpdateResult& r : results)
+        cout << " ID " << r.entityId << " — " << r.status << ";";
+    cout << "\n";
+
+    // Сховище з журналом: фіксацій за секунду залежно від вікна групової фіксації
+    telemetry::flush();
+    cout << "\n---Сховище сутностей із груповою фіксацією ---\n";
+    // Журнали демонстрації — у тимчасовому каталозі, видаляються наприкінці
+    const string walPath = (filesystem::temp_directory_path() / "lab8_entities.wal").string();
+    const int writers = 8, updatesPerWriter = 100;
+    for (int windowUs : {0, 100, 1000, 5000}) {
+        remove(walPath.c_str());
+        EntityStore store(walPath, chrono::microseconds(windowUs));
+        vector<unique_ptr<OrderUpdater>> updaters;
+        for (int w = 0; w < writers; ++w) {
+            updaters.push_back(make_unique<OrderUpdater>());
+            updaters.back()->setVerbose(false);
+            updaters.back()->attachStore(&store);
+        }
+        store.open();
+
+        auto storeStart = chrono::steady_clock::now();
+        vector<thread> threads;
+        for (int w = 0; w < writers; ++w) {
+            threads.emplace_back([&, w] {
+                for (int i = 0; i < updatesPerWriter; ++i)
+                    updaters[w]->update(w * updatesPerWriter + i, orderData);
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        double storeSeconds = chrono::duration<double>(chrono::steady_clock::now() - storeStart).count();
+        cout << "вікно " << windowUs << " мкс: " << (size_t)(writers * updatesPerWriter / storeSeconds)
+             << " фіксацій/с, " << store.getSyncCount() << " fsync\n";
+    }
+
+    // Трасування кроків: гістограми "<таблиця>.<крок>" у зведенні телеметрії і траса Chrome
+    telemetry::flush();
+    cout << "\n---Трасування кроків оновлення ---\n";
+    telemetry::setTiming(true);
+    const string tracePath = (filesystem::temp_directory_path() / "lab8_update_trace.json").string();
+    bool tracing = telemetry::Telemetry::instance().startTrace(tracePath);
+    benchmark("ProductUpdater (трасування увімкнено)", product, productData, 2000);
+    benchmark("OrderUpdater (трасування увімкнено)", order, orderData, 2000);
+    if (tracing) {
+        telemetry::Telemetry::instance().stopTrace();
+        cout << "Трасу збережено в " << tracePath << " (видаляється після завершення)\n";
+    }
+    telemetry::setTiming(timingWasOn);
+
+    // Повторна синхронізація без змін пропускається; конкурентні записи — через CAS версій
+    bool partialUpdateOk = false;
+    telemetry::flush();
+    cout << "\n---Диференціальне оновлення і оптимістична конкуренція ---\n";
+    const string productsWalPath = (filesystem::temp_directory_path() / "lab8_products.wal").string();
+    {
+        remove(productsWalPath.c_str());
+        EntityStore store(productsWalPath, chrono::microseconds(0));
+        ProductUpdater first;
+        first.attachStore(&store);
+        store.open();
+
+        Record price = first.makeRecord();
+        price.set(ProductFields::Price, "1200");
+        first.update(7, price);
+        first.update(7, price); // ті самі дані — нічого не надсилається
+
+        const int racers = 4;
+        vector<unique_ptr<ProductUpdater>> updaters;
+        for (int r = 0; r < racers; ++r) {
+            updaters.push_back(make_unique<ProductUpdater>());
+            updaters.back()->setVerbose(false);
+            updaters.back()->attachStore(&store);
+        }
+        vector<thread> threads;
+        for (int r = 0; r < racers; ++r) {
+            threads.emplace_back([&, r] {
+                Record data = updaters[r]->makeRecord();
+                for (int i = 0; i < 50; ++i) {
+                    data.set(ProductFields::Price, to_string(100 + r * 1000 + i));
+                    updaters[r]->update(7, data);
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        size_t retries = 0;
+        for (auto& u : updaters)
+            retries += u->getConflictRetries();
+        Record final = first.makeRecord();
+        int table = store.createTable("product", ProductFields::schema());
+        store.get(table, 7, final);
+        telemetry::flush();
+        cout << "Версія продукту 7: " << final.getVersion() << ", повторів через конфлікт: " << retries << "\n";
+
+        // Зміна суми при тому самому статусі: статус не повинен затертися порожнім рядком
+        OrderUpdater orders;
+        orders.setVerbose(false);
+        orders.attachStore(&store);
+        Record shipped = orders.makeRecord();
+        shipped.set(OrderFields::Status, "shipped");
+        shipped.set(OrderFields::Total, "1500");
+        orders.update(5, shipped);
+        shipped.set(OrderFields::Total, "1700");
+        orders.update(5, shipped);
+        Record stored = orders.makeRecord();
+        store.get(store.createTable("order", OrderFields::schema()), 5, stored);
+        partialUpdateOk = stored.get(OrderFields::Status) == "shipped" && stored.get(OrderFields::Total) == "1700";
+        cout << "Замовлення 5: статус " << stored.get(OrderFields::Status) << ", сума " << stored.get(OrderFields::Total)
+             << " — незмінені поля збережено: " << (partialUpdateOk ? "так" : "ні") << "\n";
+
+        // Дві зміни однієї сутності в пакеті: друга порівнюється з рядком після першої
+        ProductUpdater batcher;
+        batcher.setVerbose(false);
+        batcher.attachStore(&store);
+        Record cheap = batcher.makeRecord(), dear = batcher.makeRecord();
+        cheap.set(ProductFields::Price, "50");
+        dear.set(ProductFields::Price, "100");
+        const vector<EntityUpdate> sameId = {{8, dear}, {8, cheap}};
+        vector<UpdateResult> sameIdResults;
+        for (int mode = 0; mode < 2; ++mode) {
+            batcher.update(8, cheap);
+            if (mode == 0)
+                batcher.updateMany(sameId, sameIdResults);
+            else
+                batcher.updatePipelined(sameId, sameIdResults);
+            Record row = batcher.makeRecord();
+            store.get(store.createTable("product", ProductFields::schema()), 8, row);
+            bool ok = row.get(ProductFields::Price) == "50" && sameIdResults[0].success && sameIdResults[1].success
+                   && sameIdResults[1].status != "unchanged";
+            partialUpdateOk = partialUpdateOk && ok;
+            cout << (mode == 0 ? "updateMany" : "updatePipelined") << " [100, 50] для продукту 8: ціна "
+                 << row.get(ProductFields::Price) << ", друге оновлення — " << sameIdResults[1].status
+                 << " — як послідовні update: " << (ok ? "так" : "НІ") << "\n";
+        }
+    }
+
+    // Журнал із таблицею, якої немає у сховищі, не обрізається: open() повідомляє помилку
+    bool schemaCheckOk = false;
+    {
+        auto walBytes = filesystem::file_size(productsWalPath);
+        EntityStore partial(productsWalPath);
+        partial.createTable("product", ProductFields::schema());
+        try {
+            partial.open();
+        } catch (const runtime_error& e) {
+            schemaCheckOk = filesystem::file_size(productsWalPath) == walBytes;
+            cout << "Сховище без таблиці order: " << e.what() << "\n";
+        }
+        cout << "Журнал не обрізано: " << (schemaCheckOk ? "так" : "НІ") << "\n";
+    }
+    remove(productsWalPath.c_str());
+
+    // Відновлення таблиць із журналу після перезапуску. Збій посеред запису часто
+    // лишає хвіст із нулів — він не проходить перевірку CRC32 і обрізається.
+    bool walTailOk = false;
+    auto walSize = filesystem::file_size(walPath);
+    {
+        ofstream tail(walPath, ios::binary | ios::app);
+        tail << string(4096, '\0');
+    }
+    {
+        EntityStore store(walPath);
+        OrderUpdater recovered;
+        recovered.attachStore(&store);
+        int table = store.createTable("order", OrderFields::schema());
+        auto recoveryStart = chrono::steady_clock::now();
+        store.open();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - recoveryStart).count();
+        cout << "Відновлено " << store.rowCount(table) << " замовлень за " << ms << " мс\n";
+        walTailOk = store.rowCount(table) == (size_t)(writers * updatesPerWriter)
+                 && filesystem::file_size(walPath) == walSize;
+        cout << "Хвіст журналу з 4096 нулів відкинуто й обрізано: " << (walTailOk ? "так" : "НІ") << "\n";
+    }
+    remove(walPath.c_str());
+    remove(tracePath.c_str());
+
+    telemetry::Telemetry::instance().report(cout);
+
+    return partialUpdateOk && schemaCheckOk && walTailOk ? 0 : 1;
+}
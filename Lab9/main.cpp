@@ -1,146 +1,1835 @@
-#include <iostream>
-#include <vector>
-#include <string>
-#include <windows.h>
-using namespace std;
-
-// === Інтерфейс "Відвідувач" ===
-class Department;
-class Employee;
-class Company;
-
-class Visitor {
-public:
-    virtual void visit(Company* company) = 0;
-    virtual void visit(Department* department) = 0;
-    virtual void visit(Employee* employee) = 0;
-    virtual ~Visitor() = default;
-};
-
-// === Інтерфейс елементів, які приймають відвідувача ===
-class Element {
-public:
-    virtual void accept(Visitor* visitor) = 0;
-    virtual ~Element() = default;
-};
-
-// === Клас "Співробітник" ===
-class Employee : public Element {
-    string position;
-    double salary;
-
-public:
-    Employee(string pos, double sal) : position(pos), salary(sal) {}
-
-    string getPosition() const { return position; }
-    double getSalary() const { return salary; }
-
-    void accept(Visitor* visitor) override {
-        visitor->visit(this);
-    }
-};
-
-// === Клас "Департамент" ===
-class Department : public Element {
-    string name;
-    vector<Employee*> employees;
-
-public:
-    Department(string n, vector<Employee*> emps) : name(n), employees(emps) {}
-
-    string getName() const { return name; }
-    vector<Employee*> getEmployees() const { return employees; }
-
-    void accept(Visitor* visitor) override {
-        visitor->visit(this);
-    }
-};
-
-// === Клас "Компанія" ===
-class Company : public Element {
-    string name;
-    vector<Department*> departments;
-
-public:
-    Company(string n, vector<Department*> deps) : name(n), departments(deps) {}
-
-    string getName() const { return name; }
-    vector<Department*> getDepartments() const { return departments; }
-
-    void accept(Visitor* visitor) override {
-        visitor->visit(this);
-    }
-};
-
-// === Конкретний відвідувач — "Зарплатна відомість" ===
-class SalaryReportVisitor : public Visitor {
-    double totalCompanySalary = 0;
-    double currentDeptSalary = 0;
-    string currentDeptName;
-
-public:
-    void visit(Company* company) override {
-        cout << "\n===== Зарплатна відомість для компанії: " << company->getName() << " =====\n";
-
-        for (auto dep : company->getDepartments()) {
-            dep->accept(this);
-            totalCompanySalary += currentDeptSalary;
-            cout << "  -> Загальна зарплата у департаменті [" << currentDeptName << "]: "
-                 << currentDeptSalary << " грн\n";
-            currentDeptSalary = 0;
-        }
-
-        cout << "\n💰 Загальний фонд оплати праці компанії: " << totalCompanySalary << " грн\n";
-    }
-
-    void visit(Department* department) override {
-        currentDeptName = department->getName();
-        cout << "\n--- Департамент: " << currentDeptName << " ---\n";
-
-        for (auto emp : department->getEmployees()) {
-            emp->accept(this);
-        }
-    }
-
-    void visit(Employee* employee) override {
-        cout << "Посада: " << employee->getPosition()
-             << " | Зарплата: " << employee->getSalary() << " грн\n";
-        currentDeptSalary += employee->getSalary();
-    }
-};
-
-// === Клієнтський код ===
-int main() {
-    SetConsoleOutputCP(65001);
-
-    // Створюємо співробітників
-    Employee* e1 = new Employee("Менеджер", 25000);
-    Employee* e2 = new Employee("Аналітик", 20000);
-    Employee* e3 = new Employee("Програміст", 30000);
-    Employee* e4 = new Employee("Тестувальник", 22000);
-
-    // Створюємо департаменти
-    Department* d1 = new Department("Відділ Продажів", {e1, e2});
-    Department* d2 = new Department("IT Відділ", {e3, e4});
-
-    // Створюємо компанію
-    Company* company = new Company("TechCorp", {d1, d2});
-
-    // Створюємо відвідувача
-    SalaryReportVisitor* reportVisitor = new SalaryReportVisitor();
-
-    // Формуємо звіт для всієї компанії
-    company->accept(reportVisitor);
-
-    // Формуємо звіт тільки для одного департаменту
-    cout << "\n\n===== Звіт тільки для одного департаменту =====\n";
-    d2->accept(reportVisitor);
-
-    // Прибираємо пам’ять
-    delete e1; delete e2; delete e3; delete e4;
-    delete d1; delete d2;
-    delete company;
-    delete reportVisitor;
-
-    return 0;
-}
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+#include <stdexcept>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <array>
+#include <limits>
+#include <variant>
+#include <type_traits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ANALYTICS_USE_SSE2
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// === Невласницьке представлення неперервного діапазону (аналог std::span) ===
+// Як і ітератори vector, стає недійсним після зміни власника. У налагоджувальній
+// збірці діапазон пам'ятає лічильник змін власника і перевіряє його при доступі.
+template <typename T>
+class Span {
+    T* first;
+    size_t count;
+#ifndef NDEBUG
+    const uint64_t* ownerGeneration = nullptr;
+    uint64_t generation = 0;
+#endif
+
+    void checkValid() const {
+#ifndef NDEBUG
+        assert((!ownerGeneration || *ownerGeneration == generation) && "Span використано після зміни власника");
+#endif
+    }
+
+public:
+    Span(T* data = nullptr, size_t size = 0) : first(data), count(size) {}
+    Span(T* data, size_t size, const uint64_t* owner) : first(data), count(size) {
+#ifndef NDEBUG
+        ownerGeneration = owner;
+        generation = *owner;
+#else
+        (void)owner;
+#endif
+    }
+
+    T* begin() const { checkValid(); return first; }
+    T* end() const { checkValid(); return first + count; }
+    T* data() const { checkValid(); return first; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t i) const { checkValid(); return first[i]; }
+};
+
+// === Інтерфейс "Відвідувач" ===
+class Department;
+class Employee;
+class Company;
+
+class Visitor {
+public:
+    virtual void visit(Company* company) = 0;
+    virtual void visit(Department* department) = 0;
+    virtual void visit(Employee* employee) = 0;
+    virtual ~Visitor() = default;
+};
+
+// === Інтерфейс елементів, які приймають відвідувача ===
+class Element {
+public:
+    virtual void accept(Visitor* visitor) = 0;
+    virtual ~Element() = default;
+};
+
+// === Клас "Співробітник" ===
+// Легкий фасад над рядком у колонках компанії: дані зберігає Company
+class Employee : public Element {
+    const Company* company;
+    uint32_t index; // позиція в колонках компанії
+
+public:
+    Employee(const Company* c, uint32_t i) : company(c), index(i) {}
+
+    // Стабільний ідентифікатор співробітника (не змінюється при переміщеннях)
+    uint32_t getId() const;
+    const string& getPosition() const;
+    double getSalary() const;
+
+    void accept(Visitor* visitor) override {
+        visitor->visit(this);
+    }
+};
+
+// === Клас "Департамент" ===
+// Співробітники департаменту займають неперервний діапазон [begin, begin + count)
+class Department : public Element {
+    friend class Company;
+    friend class CompanySnapshot;
+
+    Company* company;
+    uint32_t index;
+    uint32_t begin;
+    uint32_t count;
+    double totalSalary = 0; // підтримується інкрементно операціями Company
+
+public:
+    Department(Company* c, uint32_t i, uint32_t b, uint32_t n) : company(c), index(i), begin(b), count(n) {}
+
+    const string& getName() const;
+    size_t getEmployeeCount() const { return count; }
+    double getTotalSalary() const { return totalSalary; }
+    Span<Employee> getEmployees() const;
+    // Колонки зарплат і посад департаменту — для обчислень без обходу елементів
+    Span<const double> getSalaries() const;
+    Span<const uint32_t> getPositionIds() const;
+
+    void accept(Visitor* visitor) override {
+        visitor->visit(this);
+    }
+};
+
+// === Клас "Компанія" ===
+// Уся структура зберігається в кількох неперервних масивах: зарплати і посади
+// окремими колонками, співробітники згруповані за департаментами.
+// Фасади Employee/Department посилаються на компанію, тому вона не копіюється.
+// Фасад Employee позначає позицію в колонках: після hire/fire/moveEmployee за
+// тією ж адресою може бути інший співробітник, стабільним є лише getId().
+// Ці зміни роблять недійсними всі раніше отримані Span співробітників і колонок
+// (перевіряється assert у налагоджувальній збірці) і не зберігають порядок
+// співробітників усередині департаменту.
+class Company : public Element {
+    friend class Employee;
+    friend class Department;
+    friend class CompanyBuilder;
+    friend class CompanySnapshot;
+
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    string name;
+    vector<double> salaries;
+    vector<uint32_t> positionIds;
+    vector<uint32_t> employeeIds;
+    vector<uint32_t> slotOfId;      // id співробітника -> позиція в колонках
+    vector<string> positionNames;   // інтерновані назви посад
+    unordered_map<string, uint32_t> positionIndex;
+    vector<string> departmentNames;
+    vector<Employee> employees;
+    vector<Department> departments;
+    double totalSalary = 0;
+    uint64_t generation = 0; // лічильник змін структури; див. Span
+
+    explicit Company(string n) : name(move(n)) {}
+
+    uint32_t internPosition(const string& position) {
+        auto it = positionIndex.find(position);
+        if (it != positionIndex.end())
+            return it->second;
+        positionNames.push_back(position);
+        positionIndex.emplace(position, (uint32_t)positionNames.size() - 1);
+        return (uint32_t)positionNames.size() - 1;
+    }
+
+    // Повний перерахунок агрегатів (після масової побудови)
+    void recomputeAggregates() {
+        totalSalary = 0;
+        for (auto& dep : departments) {
+            dep.totalSalary = 0;
+            for (double salary : dep.getSalaries())
+                dep.totalSalary += salary;
+            totalSalary += dep.totalSalary;
+        }
+    }
+
+    uint32_t slotOf(uint32_t employeeId) const {
+        if (employeeId >= slotOfId.size() || slotOfId[employeeId] == NO_SLOT)
+            throw out_of_range("Невідомий співробітник " + to_string(employeeId));
+        return slotOfId[employeeId];
+    }
+
+    // Перевіряється до будь-яких змін у колонках; компанія без департаментів
+    // не приймає жодного індексу
+    void checkDepartment(size_t department) const {
+        if (department >= departments.size())
+            throw out_of_range("Невідомий департамент " + to_string(department));
+    }
+
+    // Департамент, якому належить позиція (діапазони впорядковані за begin)
+    size_t departmentOfSlot(uint32_t slot) const {
+        size_t lo = 0, hi = departments.size();
+        while (hi - lo > 1) {
+            size_t mid = (lo + hi) / 2;
+            if (departments[mid].begin <= slot)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        while (departments[lo].count == 0 || slot >= departments[lo].begin + departments[lo].count)
+            --lo; // порожні департаменти мають той самий begin, що й наступний
+        return lo;
+    }
+
+    // Переносить співробітника з позиції from на позицію to
+    void moveSlot(uint32_t from, uint32_t to) {
+        salaries[to] = salaries[from];
+        positionIds[to] = positionIds[from];
+        employeeIds[to] = employeeIds[from];
+        slotOfId[employeeIds[to]] = to;
+    }
+
+    // Вставляє співробітника в кінець діапазону департаменту. Місце звільняється
+    // каскадом з кінця масиву: кожен наступний департамент переносить свого першого
+    // співробітника у свій кінець — O(кількість департаментів) переносів замість
+    // зсуву всіх наступних співробітників.
+    void insertIntoDepartment(size_t department, uint32_t id, uint32_t position, double salary) {
+        ++generation;
+        salaries.push_back(0);
+        positionIds.push_back(0);
+        employeeIds.push_back(0);
+        employees.emplace_back(this, (uint32_t)employees.size());
+        for (size_t d = departments.size() - 1; d > department; --d) {
+            Department& next = departments[d];
+            // Вільна позиція — одразу за діапазоном next
+            if (next.count != 0)
+                moveSlot(next.begin, next.begin + next.count);
+            ++next.begin;
+        }
+        Department& dep = departments[department];
+        uint32_t slot = dep.begin + dep.count;
+        salaries[slot] = salary;
+        positionIds[slot] = position;
+        employeeIds[slot] = id;
+        slotOfId[id] = slot;
+        ++dep.count;
+        dep.totalSalary += salary;
+        totalSalary += salary;
+    }
+
+    // Дірку закриває останній співробітник департаменту, далі кожен наступний
+    // департамент переносить свого останнього співробітника в дірку перед собою
+    void removeSlot(uint32_t slot) {
+        ++generation;
+        size_t department = departmentOfSlot(slot);
+        Department& dep = departments[department];
+        double salary = salaries[slot];
+        slotOfId[employeeIds[slot]] = NO_SLOT;
+        uint32_t hole = dep.begin + dep.count - 1;
+        if (slot != hole)
+            moveSlot(hole, slot);
+        --dep.count;
+        for (size_t d = department + 1; d < departments.size(); ++d) {
+            Department& next = departments[d];
+            if (next.count != 0) {
+                uint32_t last = next.begin + next.count - 1;
+                if (last != hole)
+                    moveSlot(last, hole);
+                hole = last;
+            }
+            --next.begin;
+        }
+        salaries.pop_back();
+        positionIds.pop_back();
+        employeeIds.pop_back();
+        employees.pop_back();
+        dep.totalSalary -= salary;
+        totalSalary -= salary;
+    }
+
+public:
+    Company(const Company&) = delete;
+    Company& operator=(const Company&) = delete;
+
+    const string& getName() const { return name; }
+    Span<Department> getDepartments() { return {departments.data(), departments.size()}; }
+    Span<Employee> getEmployees() { return {employees.data(), employees.size(), &generation}; }
+    Span<const double> getSalaries() const { return {salaries.data(), salaries.size(), &generation}; }
+
+    // Агрегати підтримуються інкрементно: O(1) без обходу співробітників
+    size_t getEmployeeCount() const { return salaries.size(); }
+    double getTotalSalary() const { return totalSalary; }
+
+    // === Зміни в структурі компанії ===
+    uint32_t hire(size_t department, const string& position, double salary) {
+        checkDepartment(department);
+        uint32_t id = (uint32_t)slotOfId.size();
+        slotOfId.push_back(NO_SLOT);
+        insertIntoDepartment(department, id, internPosition(position), salary);
+        return id;
+    }
+
+    void fire(uint32_t employeeId) {
+        removeSlot(slotOf(employeeId));
+    }
+
+    void changeSalary(uint32_t employeeId, double salary) {
+        uint32_t slot = slotOf(employeeId);
+        double delta = salary - salaries[slot];
+        salaries[slot] = salary;
+        departments[departmentOfSlot(slot)].totalSalary += delta;
+        totalSalary += delta;
+    }
+
+    void moveEmployee(uint32_t employeeId, size_t department) {
+        checkDepartment(department);
+        uint32_t slot = slotOf(employeeId);
+        uint32_t position = positionIds[slot];
+        double salary = salaries[slot];
+        removeSlot(slot);
+        insertIntoDepartment(department, employeeId, position, salary);
+    }
+
+    void accept(Visitor* visitor) override {
+        visitor->visit(this);
+    }
+};
+
+inline uint32_t Employee::getId() const { return company->employeeIds[index]; }
+inline const string& Employee::getPosition() const { return company->positionNames[company->positionIds[index]]; }
+inline double Employee::getSalary() const { return company->salaries[index]; }
+
+inline const string& Department::getName() const { return company->departmentNames[index]; }
+inline Span<Employee> Department::getEmployees() const {
+    return {company->employees.data() + begin, count, &company->generation};
+}
+inline Span<const double> Department::getSalaries() const {
+    return {company->salaries.data() + begin, count, &company->generation};
+}
+inline Span<const uint32_t> Department::getPositionIds() const {
+    return {company->positionIds.data() + begin, count, &company->generation};
+}
+
+// === Побудова компанії ===
+// Співробітників можна додавати в будь-якому порядку; build() групує їх за департаментами
+class CompanyBuilder {
+    struct PendingEmployee {
+        uint32_t department;
+        uint32_t position;
+        double salary;
+    };
+
+    unique_ptr<Company> company;
+    vector<PendingEmployee> pending;
+
+public:
+    explicit CompanyBuilder(const string& name) : company(new Company(name)) {}
+
+    size_t addDepartment(const string& name) {
+        company->departmentNames.push_back(name);
+        return company->departmentNames.size() - 1;
+    }
+
+    // Повертає id співробітника (ids видаються в порядку додавання)
+    uint32_t addEmployee(size_t department, const string& position, double salary) {
+        return addEmployee(department, internPosition(position), salary);
+    }
+
+    // Варіант для масового завантаження: посада вже інтернована
+    uint32_t addEmployee(size_t department, uint32_t positionId, double salary) {
+        if (department >= company->departmentNames.size())
+            throw out_of_range("Невідомий департамент " + to_string(department));
+        pending.push_back({(uint32_t)department, positionId, salary});
+        return (uint32_t)pending.size() - 1;
+    }
+
+    uint32_t internPosition(const string& position) { return company->internPosition(position); }
+
+    void reserve(size_t employees) { pending.reserve(employees); }
+
+    unique_ptr<Company> build() {
+        Company& c = *company;
+        size_t depCount = c.departmentNames.size();
+
+        // Сортування підрахунком за департаментом (стабільне)
+        vector<uint32_t> offsets(depCount + 1, 0);
+        for (auto& e : pending)
+            ++offsets[e.department + 1];
+        for (size_t d = 0; d < depCount; ++d)
+            offsets[d + 1] += offsets[d];
+
+        c.salaries.assign(pending.size(), 0.0);
+        c.positionIds.assign(pending.size(), 0);
+        c.employeeIds.assign(pending.size(), 0);
+        c.slotOfId.assign(pending.size(), 0);
+        vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t id = 0; id < pending.size(); ++id) {
+            const PendingEmployee& e = pending[id];
+            uint32_t slot = cursor[e.department]++;
+            c.salaries[slot] = e.salary;
+            c.positionIds[slot] = e.position;
+            c.employeeIds[slot] = id;
+            c.slotOfId[id] = slot;
+        }
+
+        c.employees.reserve(pending.size());
+        for (uint32_t i = 0; i < pending.size(); ++i)
+            c.employees.emplace_back(&c, i);
+        c.departments.reserve(depCount);
+        for (uint32_t d = 0; d < depCount; ++d)
+            c.departments.emplace_back(&c, d, offsets[d], offsets[d + 1] - offsets[d]);
+        c.recomputeAggregates();
+
+        pending.clear();
+        return move(company);
+    }
+};
+
+// === Конкретний відвідувач — "Зарплатна відомість" ===
+class SalaryReportVisitor : public Visitor {
+    double totalCompanySalary = 0;
+    double currentDeptSalary = 0;
+    string currentDeptName;
+    vector<double> departmentTotals; // підсумки останнього обходу компанії
+    ostream& out;
+
+public:
+    explicit SalaryReportVisitor(ostream& o = cout) : out(o) {}
+
+    double getTotalCompanySalary() const { return totalCompanySalary; }
+    const vector<double>& getDepartmentTotals() const { return departmentTotals; }
+
+    void visit(Company* company) override {
+        out << "\n===== Зарплатна відомість для компанії: " << company->getName() << " =====\n";
+
+        departmentTotals.clear();
+        for (auto& dep : company->getDepartments()) {
+            dep.accept(this);
+            departmentTotals.push_back(currentDeptSalary);
+            totalCompanySalary += currentDeptSalary;
+            out << "  -> Загальна зарплата у департаменті [" << currentDeptName << "]: "
+                 << currentDeptSalary << " грн\n";
+            currentDeptSalary = 0;
+        }
+
+        out << "\n💰 Загальний фонд оплати праці компанії: " << totalCompanySalary << " грн\n";
+    }
+
+    void visit(Department* department) override {
+        currentDeptName = department->getName();
+        out << "\n--- Департамент: " << currentDeptName << " ---\n";
+
+        for (auto& emp : department->getEmployees()) {
+            emp.accept(this);
+        }
+    }
+
+    void visit(Employee* employee) override {
+        out << "Посада: " << employee->getPosition()
+             << " | Зарплата: " << employee->getSalary() << " грн\n";
+        currentDeptSalary += employee->getSalary();
+    }
+};
+
+// === Статичне відвідування (без віртуальних викликів) ===
+// Відвідувач — звичайний об'єкт-функція з перевантаженнями operator() для
+// Company&, Department& і Employee&; виклики підставляються компілятором,
+// а тип результату виводиться з обробників. Якщо якогось обробника бракує,
+// програма не компілюється. Класичний інтерфейс Visitor залишається доступним.
+template <typename... Handlers>
+struct Overloaded : Handlers... {
+    using Handlers::operator()...;
+};
+template <typename... Handlers>
+Overloaded(Handlers...) -> Overloaded<Handlers...>;
+
+using OrgNode = variant<Company*, Department*, Employee*>;
+
+template <typename F>
+constexpr bool handlesAllNodes =
+    is_invocable_v<F&, Company&> && is_invocable_v<F&, Department&> && is_invocable_v<F&, Employee&>;
+
+// Один вузол: усі обробники мають повертати той самий тип
+template <typename F>
+decltype(auto) visitNode(const OrgNode& node, F&& f) {
+    static_assert(handlesAllNodes<F>, "Відвідувач має обробляти Company, Department і Employee");
+    return visit([&](auto* n) -> decltype(auto) { return f(*n); }, node);
+}
+
+// Обхід департаменту: f(department), потім f(employee) для кожного співробітника
+template <typename F>
+void walk(Department& department, F&& f) {
+    static_assert(is_invocable_v<F&, Department&> && is_invocable_v<F&, Employee&>,
+                  "Відвідувач департаменту має обробляти Department і Employee");
+    f(department);
+    for (auto& emp : department.getEmployees())
+        f(emp);
+}
+
+// Обхід компанії в тому ж порядку, що й класичний accept
+template <typename F>
+void walk(Company& company, F&& f) {
+    static_assert(handlesAllNodes<F>, "Відвідувач компанії має обробляти Company, Department і Employee");
+    f(company);
+    for (auto& dep : company.getDepartments())
+        walk(dep, f);
+}
+
+// Згортка по співробітниках департаменту; тип результату — тип, який повертає f
+template <typename F>
+auto reduceEmployees(Department& department, F&& f) {
+    static_assert(is_invocable_v<F&, Employee&>, "Функція має приймати Employee");
+    invoke_result_t<F&, Employee&> result{};
+    for (auto& emp : department.getEmployees())
+        result += f(emp);
+    return result;
+}
+
+// Плоский список вузлів у порядку обходу (для диспетчеризації через variant)
+vector<OrgNode> flattenNodes(Company& company) {
+    vector<OrgNode> nodes;
+    nodes.reserve(1 + company.getDepartments().size() + company.getEmployees().size());
+    walk(company, [&](auto& node) { nodes.push_back(&node); });
+    return nodes;
+}
+
+// Класичний відвідувач, що лише сумує зарплати (для порівняння швидкості обходу)
+class SalaryTotalVisitor : public Visitor {
+    double total = 0;
+    size_t nodes = 0;
+
+public:
+    double getTotal() const { return total; }
+    size_t getNodeCount() const { return nodes; }
+
+    void visit(Company* company) override {
+        ++nodes;
+        for (auto& dep : company->getDepartments())
+            dep.accept(this);
+    }
+
+    void visit(Department* department) override {
+        ++nodes;
+        for (auto& emp : department->getEmployees())
+            emp.accept(this);
+    }
+
+    void visit(Employee* employee) override {
+        ++nodes;
+        total += employee->getSalary();
+    }
+};
+
+// === Пул потоків із крадіжкою роботи ===
+// Кожен потік має власну деку завдань: бере з кінця своєї, а коли вона
+// порожня — краде з початку чужих.
+class WorkStealingPool {
+    struct WorkerQueue {
+        deque<function<void()>> tasks;
+        mutex mtx;
+    };
+
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<thread> threads;
+    // Завдань у деках, ще не взятих. Змінюється лише під stateMutex, як і читається
+    // в умові очікування wake: лічильник збільшується до публікації завдань і
+    // зменшується після взяття, тому не буває меншим за кількість завдань у деках
+    size_t queued = 0;
+    atomic<size_t> pending{0};  // завдань, ще не виконаних
+    mutex stateMutex;
+    condition_variable wake, done;
+    bool stopping = false;
+
+    bool popLocal(size_t id, function<void()>& task) {
+        WorkerQueue& q = *queues[id];
+        lock_guard<mutex> lock(q.mtx);
+        if (q.tasks.empty())
+            return false;
+        task = move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t id, function<void()>& task) {
+        for (size_t k = 1; k < queues.size(); ++k) {
+            WorkerQueue& q = *queues[(id + k) % queues.size()];
+            lock_guard<mutex> lock(q.mtx);
+            if (!q.tasks.empty()) {
+                task = move(q.tasks.front());
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t id) {
+        function<void()> task;
+        while (true) {
+            if (popLocal(id, task) || steal(id, task)) {
+                {
+                    lock_guard<mutex> lock(stateMutex);
+                    --queued;
+                }
+                task();
+                if (--pending == 0) {
+                    lock_guard<mutex> lock(stateMutex);
+                    done.notify_all();
+                }
+                continue;
+            }
+            unique_lock<mutex> lock(stateMutex);
+            wake.wait(lock, [&] { return stopping || queued > 0; });
+            if (stopping)
+                return;
+        }
+    }
+
+public:
+    explicit WorkStealingPool(size_t threadCount = thread::hardware_concurrency()) {
+        threadCount = max<size_t>(threadCount, 1);
+        for (size_t i = 0; i < threadCount; ++i)
+            queues.push_back(make_unique<WorkerQueue>());
+        for (size_t i = 0; i < threadCount; ++i)
+            threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : threads)
+            t.join();
+    }
+
+    size_t size() const { return threads.size(); }
+
+    // Розкладає завдання по деках потоків і чекає, поки всі виконаються
+    void run(vector<function<void()>>& tasks) {
+        if (tasks.empty())
+            return;
+        pending += tasks.size();
+        {
+            // Лічильник збільшується до того, як завдання стануть видимими потокам
+            lock_guard<mutex> lock(stateMutex);
+            queued += tasks.size();
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                WorkerQueue& q = *queues[i % queues.size()];
+                lock_guard<mutex> queueLock(q.mtx);
+                q.tasks.push_back(move(tasks[i]));
+            }
+        }
+        wake.notify_all();
+
+        unique_lock<mutex> lock(stateMutex);
+        done.wait(lock, [&] { return pending == 0; });
+        tasks.clear();
+    }
+};
+
+// === Паралельний відвідувач — "Зарплатна відомість" ===
+// Департаменти діляться на діапазони співробітників, які обробляються пулом.
+// Кожне завдання накопичує власну часткову суму і власний фрагмент тексту;
+// результати зливаються в порядку діапазонів, тому звіт і підсумки однакові
+// за будь-якої кількості потоків і збігаються з послідовним обходом.
+class ParallelSalaryReportVisitor : public Visitor {
+    struct Chunk {
+        Department* department;
+        size_t begin;
+        size_t end;
+        double salary = 0;
+        string text;
+    };
+
+    WorkStealingPool& pool;
+    ostream& out;
+    size_t chunkSize;
+
+    void formatEmployee(ostream& os, const Employee& employee) {
+        os << "Посада: " << employee.getPosition()
+           << " | Зарплата: " << employee.getSalary() << " грн\n";
+    }
+
+    // Розбиває департаменти на діапазони; firstChunk[d] — перший діапазон департаменту d
+    vector<Chunk> runChunks(Department* departments, size_t count, vector<size_t>& firstChunk) {
+        vector<Chunk> chunks;
+        firstChunk.clear();
+        for (size_t d = 0; d < count; ++d) {
+            firstChunk.push_back(chunks.size());
+            size_t size = departments[d].getEmployees().size();
+            for (size_t b = 0; b < size; b += chunkSize)
+                chunks.push_back({&departments[d], b, min(b + chunkSize, size)});
+        }
+        firstChunk.push_back(chunks.size());
+
+        vector<function<void()>> tasks;
+        for (auto& chunk : chunks) {
+            Chunk* c = &chunk;
+            tasks.push_back([this, c] {
+                ostringstream text;
+                Span<Employee> employees = c->department->getEmployees();
+                for (size_t i = c->begin; i < c->end; ++i) {
+                    formatEmployee(text, employees[i]);
+                    c->salary += employees[i].getSalary();
+                }
+                c->text = text.str();
+            });
+        }
+        pool.run(tasks);
+        return chunks;
+    }
+
+public:
+    ParallelSalaryReportVisitor(WorkStealingPool& p, ostream& o = cout, size_t chunk = 16384)
+        : pool(p), out(o), chunkSize(max<size_t>(chunk, 1)) {}
+
+    void visit(Company* company) override {
+        out << "\n===== Зарплатна відомість для компанії: " << company->getName() << " =====\n";
+
+        Span<Department> departments = company->getDepartments();
+        vector<size_t> firstChunk;
+        vector<Chunk> chunks = runChunks(departments.data(), departments.size(), firstChunk);
+
+        double totalCompanySalary = 0;
+        for (size_t d = 0; d < departments.size(); ++d) {
+            double deptSalary = 0;
+            out << "\n--- Департамент: " << departments[d].getName() << " ---\n";
+            for (size_t c = firstChunk[d]; c < firstChunk[d + 1]; ++c) {
+                out << chunks[c].text;
+                deptSalary += chunks[c].salary;
+            }
+            totalCompanySalary += deptSalary;
+            out << "  -> Загальна зарплата у департаменті [" << departments[d].getName() << "]: "
+                << deptSalary << " грн\n";
+        }
+
+        out << "\n💰 Загальний фонд оплати праці компанії: " << totalCompanySalary << " грн\n";
+    }
+
+    void visit(Department* department) override {
+        out << "\n--- Департамент: " << department->getName() << " ---\n";
+        vector<size_t> firstChunk;
+        for (auto& chunk : runChunks(department, 1, firstChunk))
+            out << chunk.text;
+    }
+
+    void visit(Employee* employee) override {
+        formatEmployee(out, *employee);
+    }
+};
+
+// === Ядро агрегатів над неперервною колонкою зарплат: сума, мінімум, максимум ===
+inline void salaryKernel(const double* salaries, size_t count, double& sum, double& minimum, double& maximum) {
+    size_t i = 0;
+#ifdef ANALYTICS_USE_SSE2
+    if (count >= 2) {
+        __m128d vSum = _mm_setzero_pd();
+        __m128d vMin = _mm_set1_pd(minimum);
+        __m128d vMax = _mm_set1_pd(maximum);
+        for (; i + 2 <= count; i += 2) {
+            __m128d s = _mm_loadu_pd(salaries + i);
+            vSum = _mm_add_pd(vSum, s);
+            vMin = _mm_min_pd(vMin, s);
+            vMax = _mm_max_pd(vMax, s);
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, vSum);
+        sum += lanes[0] + lanes[1];
+        _mm_storeu_pd(lanes, vMin);
+        minimum = min(lanes[0], lanes[1]);
+        _mm_storeu_pd(lanes, vMax);
+        maximum = max(lanes[0], lanes[1]);
+    }
+#endif
+    // Залишок (або вся робота, якщо SSE2 недоступний)
+    for (; i < count; ++i) {
+        sum += salaries[i];
+        minimum = min(minimum, salaries[i]);
+        maximum = max(maximum, salaries[i]);
+    }
+}
+
+// === Скетч квантилів із логарифмічно-лінійними кошиками ===
+// Кошик визначається порядком числа і старшими SUB_BITS бітами мантиси, тому
+// додавання — кілька бітових операцій, а відносна похибка квантиля не більша
+// за 1 / 2^(SUB_BITS + 1) (~1.6%). Значення < 1 потрапляють у нульовий кошик.
+// Скетчі зливаються додаванням лічильників.
+class SalarySketch {
+    static constexpr int SUB_BITS = 5;
+    static constexpr int EXPONENTS = 48; // покриває значення до 2^48
+    static constexpr size_t BUCKETS = 1 + (size_t(EXPONENTS) << SUB_BITS);
+
+    array<uint32_t, BUCKETS> counts{};
+    uint64_t total = 0;
+
+    static size_t bucketOf(double value) {
+        if (!(value >= 1.0))
+            return 0;
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        int exponent = int((bits >> 52) & 0x7FF) - 1023;
+        if (exponent >= EXPONENTS)
+            return BUCKETS - 1;
+        return 1 + (size_t(exponent) << SUB_BITS) + size_t((bits >> (52 - SUB_BITS)) & ((1u << SUB_BITS) - 1));
+    }
+
+    // Середина кошика
+    static double valueOf(size_t bucket) {
+        if (bucket == 0)
+            return 0;
+        size_t b = bucket - 1;
+        double mantissa = 1.0 + ((b & ((1u << SUB_BITS) - 1)) + 0.5) / (1u << SUB_BITS);
+        return ldexp(mantissa, int(b >> SUB_BITS));
+    }
+
+public:
+    void add(double value) {
+        ++counts[bucketOf(value)];
+        ++total;
+    }
+
+    void merge(const SalarySketch& other) {
+        for (size_t b = 0; b < BUCKETS; ++b)
+            counts[b] += other.counts[b];
+        total += other.total;
+    }
+
+    uint64_t size() const { return total; }
+
+    // q у [0, 1]
+    double quantile(double q) const {
+        if (total == 0)
+            return 0;
+        uint64_t rank = uint64_t(q * double(total - 1));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            seen += counts[b];
+            if (seen > rank)
+                return valueOf(b);
+        }
+        return valueOf(BUCKETS - 1);
+    }
+};
+
+// === Зведена статистика групи ===
+struct SalaryStats {
+    size_t count = 0;
+    double sum = 0;
+    double minimum = numeric_limits<double>::infinity();
+    double maximum = -numeric_limits<double>::infinity();
+    SalarySketch sketch;
+
+    double mean() const { return count ? sum / count : 0; }
+
+    // Оцінка скетча, обмежена точними мінімумом і максимумом
+    double quantile(double q) const {
+        return count ? min(max(sketch.quantile(q), minimum), maximum) : 0;
+    }
+
+    void add(double salary) {
+        ++count;
+        sum += salary;
+        minimum = min(minimum, salary);
+        maximum = max(maximum, salary);
+        sketch.add(salary);
+    }
+
+    void merge(const SalaryStats& other) {
+        count += other.count;
+        sum += other.sum;
+        minimum = min(minimum, other.minimum);
+        maximum = max(maximum, other.maximum);
+        sketch.merge(other.sketch);
+    }
+};
+
+// === Відвідувач "Зарплатна аналітика" ===
+// За один обхід рахує кількість, суму, мінімум, максимум, середнє і квантилі
+// p50/p90/p99 для компанії, кожного департаменту і кожної посади.
+// Департамент обробляється блоком над його колонками зарплат і посад.
+class SalaryAnalyticsVisitor : public Visitor {
+    SalaryStats totals;
+    vector<string> departmentNames;
+    vector<SalaryStats> departmentStats;
+    vector<string> positionNames;
+    vector<SalaryStats> positionStats;
+
+    SalaryStats& positionGroup(uint32_t position, const string& name) {
+        if (position >= positionStats.size()) {
+            positionStats.resize(position + 1);
+            positionNames.resize(position + 1);
+        }
+        if (positionNames[position].empty())
+            positionNames[position] = name;
+        return positionStats[position];
+    }
+
+    static void printRow(ostream& out, const string& name, const SalaryStats& s) {
+        if (s.count == 0) {
+            out << name << ": немає співробітників\n";
+            return;
+        }
+        out << name << ": " << s.count << " осіб | сума " << s.sum << " | мін " << s.minimum
+            << " | макс " << s.maximum << " | середнє " << s.mean() << " | p50 " << s.quantile(0.5)
+            << " | p90 " << s.quantile(0.9) << " | p99 " << s.quantile(0.99) << "\n";
+    }
+
+public:
+    const SalaryStats& getTotals() const { return totals; }
+    const vector<SalaryStats>& getDepartmentStats() const { return departmentStats; }
+    const vector<SalaryStats>& getPositionStats() const { return positionStats; }
+    const vector<string>& getPositionNames() const { return positionNames; }
+
+    void visit(Company* company) override {
+        totals = SalaryStats();
+        departmentNames.clear();
+        departmentStats.clear();
+        positionNames.clear();
+        positionStats.clear();
+        departmentStats.reserve(company->getDepartments().size());
+        for (auto& dep : company->getDepartments())
+            dep.accept(this);
+    }
+
+    void visit(Department* department) override {
+        Span<const double> salaries = department->getSalaries();
+        Span<const uint32_t> positions = department->getPositionIds();
+        Span<Employee> employees = department->getEmployees();
+
+        departmentNames.push_back(department->getName());
+        departmentStats.emplace_back();
+        SalaryStats& dep = departmentStats.back();
+        dep.count = salaries.size();
+        salaryKernel(salaries.data(), salaries.size(), dep.sum, dep.minimum, dep.maximum);
+
+        for (size_t i = 0; i < salaries.size(); ++i) {
+            double salary = salaries[i];
+            uint32_t position = positions[i];
+            dep.sketch.add(salary);
+            SalaryStats& group = position < positionStats.size() && !positionNames[position].empty()
+                ? positionStats[position]
+                : positionGroup(position, employees[i].getPosition());
+            group.add(salary);
+        }
+        totals.merge(dep);
+    }
+
+    void visit(Employee* employee) override {
+        totals.add(employee->getSalary());
+    }
+
+    void print(ostream& out) const {
+        out << "\n===== Зарплатна аналітика =====\n";
+        printRow(out, "Компанія", totals);
+        out << "--- За департаментами ---\n";
+        for (size_t d = 0; d < departmentStats.size(); ++d)
+            printRow(out, departmentNames[d], departmentStats[d]);
+        out << "--- За посадами ---\n";
+        for (size_t p = 0; p < positionStats.size(); ++p)
+            if (positionStats[p].count)
+                printRow(out, positionNames[p], positionStats[p]);
+    }
+};
+
+// === Класичний відвідувач однієї метрики (для порівняння з SalaryAnalyticsVisitor) ===
+// Кожна метрика — окремий повний обхід через accept/visit для кожного співробітника.
+enum class SalaryMetric { Count, Sum, Min, Max, Mean, P50, P90, P99 };
+
+class SingleMetricVisitor : public Visitor {
+    struct Group {
+        size_t count = 0;
+        double value = 0;
+        vector<double> values; // лише для квантилів
+    };
+
+    SalaryMetric metric;
+    Group company;
+    vector<Group> departments;
+    unordered_map<string, Group> positions;
+
+    void add(Group& g, double salary) {
+        switch (metric) {
+        case SalaryMetric::Min: g.value = g.count ? min(g.value, salary) : salary; break;
+        case SalaryMetric::Max: g.value = g.count ? max(g.value, salary) : salary; break;
+        case SalaryMetric::Sum:
+        case SalaryMetric::Mean: g.value += salary; break;
+        case SalaryMetric::P50:
+        case SalaryMetric::P90:
+        case SalaryMetric::P99: g.values.push_back(salary); break;
+        case SalaryMetric::Count: break;
+        }
+        ++g.count;
+    }
+
+    double result(const Group& g) const {
+        switch (metric) {
+        case SalaryMetric::Count: return double(g.count);
+        case SalaryMetric::Mean: return g.count ? g.value / g.count : 0;
+        case SalaryMetric::P50: return exactQuantile(g.values, 0.5);
+        case SalaryMetric::P90: return exactQuantile(g.values, 0.9);
+        case SalaryMetric::P99: return exactQuantile(g.values, 0.99);
+        default: return g.value;
+        }
+    }
+
+    static double exactQuantile(vector<double> values, double q) {
+        if (values.empty())
+            return 0;
+        auto nth = values.begin() + size_t(q * double(values.size() - 1));
+        nth_element(values.begin(), nth, values.end());
+        return *nth;
+    }
+
+public:
+    explicit SingleMetricVisitor(SalaryMetric m) : metric(m) {}
+
+    double getCompanyResult() const { return result(company); }
+    double getDepartmentResult(size_t d) const { return result(departments[d]); }
+
+    void visit(Company* c) override {
+        company = Group();
+        departments.clear();
+        positions.clear();
+        for (auto& dep : c->getDepartments())
+            dep.accept(this);
+    }
+
+    void visit(Department* department) override {
+        departments.emplace_back();
+        for (auto& emp : department->getEmployees())
+            emp.accept(this);
+    }
+
+    void visit(Employee* employee) override {
+        double salary = employee->getSalary();
+        add(company, salary);
+        if (!departments.empty())
+            add(departments.back(), salary);
+        add(positions[employee->getPosition()], salary);
+    }
+};
+
+// === Потокове завантаження компанії з CSV ===
+// Формат рядка: департамент,посада,зарплата (рядок-заголовок "department,..." пропускається;
+// лапки в полях не підтримуються). Файл читається пакетами фіксованого розміру,
+// кожен пакет ділиться на частини за межами рядків і розбирається пулом потоків.
+// Рядки без трьох полів або з нечисловою зарплатою відкидаються і рахуються.
+class CsvCompanyLoader {
+    struct ParsedChunk {
+        const char* begin;
+        const char* end;
+        vector<string> departments;        // локальні назви департаментів
+        vector<string> positions;          // локальні назви посад
+        vector<uint32_t> departmentIds;    // по рядку: локальний id департаменту
+        vector<uint32_t> positionIds;      // по рядку: локальний id посади
+        vector<double> salaries;
+        size_t badRows = 0;
+    };
+
+    WorkStealingPool& pool;
+    size_t blockSize;
+    size_t badRows = 0;
+
+    static uint32_t internLocal(unordered_map<string, uint32_t>& index, vector<string>& names,
+                                const char* b, const char* e) {
+        string key(b, e);
+        auto it = index.find(key);
+        if (it != index.end())
+            return it->second;
+        names.push_back(key);
+        index.emplace(move(key), (uint32_t)names.size() - 1);
+        return (uint32_t)names.size() - 1;
+    }
+
+    static void parseChunk(ParsedChunk& chunk) {
+        unordered_map<string, uint32_t> departmentIndex, positionIndex;
+        const char* p = chunk.begin;
+        while (p < chunk.end) {
+            const char* lineEnd = find(p, chunk.end, '\n');
+            const char* contentEnd = lineEnd > p && lineEnd[-1] == '\r' ? lineEnd - 1 : lineEnd;
+            const char* c1 = find(p, contentEnd, ',');
+            const char* c2 = c1 < contentEnd ? find(c1 + 1, contentEnd, ',') : contentEnd;
+            if (p == contentEnd || (c1 - p == 10 && equal(p, c1, "department"))) {
+                // порожній рядок або заголовок
+            } else if (c2 == contentEnd) {
+                ++chunk.badRows;
+            } else {
+                char* numberEnd = nullptr;
+                double salary = strtod(c2 + 1, &numberEnd);
+                if (numberEnd == c2 + 1 || numberEnd != contentEnd) {
+                    ++chunk.badRows;
+                } else {
+                    chunk.departmentIds.push_back(internLocal(departmentIndex, chunk.departments, p, c1));
+                    chunk.positionIds.push_back(internLocal(positionIndex, chunk.positions, c1 + 1, c2));
+                    chunk.salaries.push_back(salary);
+                }
+            }
+            p = lineEnd + 1;
+        }
+    }
+
+public:
+    explicit CsvCompanyLoader(WorkStealingPool& p, size_t block = 4 << 20)
+        : pool(p), blockSize(max<size_t>(block, 1024)) {}
+
+    // Скільки рядків відкинув останній load()
+    size_t getBadRowCount() const { return badRows; }
+
+    unique_ptr<Company> load(const string& path, const string& companyName) {
+        ifstream in(path, ios::binary);
+        if (!in)
+            throw runtime_error("Не вдалося відкрити " + path);
+        badRows = 0;
+
+        CompanyBuilder builder(companyName);
+        unordered_map<string, size_t> departmentIds;
+        string buffer, carry;
+        size_t batchSize = blockSize * pool.size();
+
+        while (true) {
+            // Пакет = залишок попереднього + наступні batchSize байтів
+            buffer.swap(carry);
+            size_t prefix = buffer.size();
+            buffer.resize(prefix + batchSize);
+            in.read(&buffer[prefix], batchSize);
+            buffer.resize(prefix + (size_t)in.gcount());
+            bool last = !in;
+
+            // Неповний останній рядок переносимо в наступний пакет
+            size_t usable = buffer.size();
+            if (!last) {
+                size_t nl = buffer.rfind('\n');
+                usable = nl == string::npos ? 0 : nl + 1;
+            }
+            carry.assign(buffer, usable, string::npos);
+
+            // Ділимо пакет на частини по межах рядків
+            vector<ParsedChunk> chunks;
+            const char* data = buffer.data();
+            size_t pos = 0;
+            while (pos < usable) {
+                size_t end = min(pos + blockSize, usable);
+                while (end < usable && data[end - 1] != '\n')
+                    ++end;
+                chunks.push_back({data + pos, data + end});
+                pos = end;
+            }
+
+            vector<function<void()>> tasks;
+            for (auto& chunk : chunks) {
+                ParsedChunk* c = &chunk;
+                tasks.push_back([c] { parseChunk(*c); });
+            }
+            pool.run(tasks);
+
+            // Злиття в порядку частин: локальні id -> глобальні
+            for (auto& chunk : chunks) {
+                vector<size_t> depMap;
+                for (auto& name : chunk.departments) {
+                    auto it = departmentIds.find(name);
+                    if (it == departmentIds.end())
+                        it = departmentIds.emplace(name, builder.addDepartment(name)).first;
+                    depMap.push_back(it->second);
+                }
+                vector<uint32_t> posMap;
+                for (auto& name : chunk.positions)
+                    posMap.push_back(builder.internPosition(name));
+                for (size_t i = 0; i < chunk.salaries.size(); ++i)
+                    builder.addEmployee(depMap[chunk.departmentIds[i]], posMap[chunk.positionIds[i]], chunk.salaries[i]);
+                badRows += chunk.badRows;
+            }
+
+            if (last)
+                break;
+        }
+        return builder.build();
+    }
+};
+
+// === Файл, відображений у пам'ять (лише читання) ===
+class MappedFile {
+    const char* data = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw runtime_error("Не вдалося відкрити " + path);
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+        length = (size_t)size.QuadPart;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+            throw runtime_error("Не вдалося відобразити " + path);
+        data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw runtime_error("Не вдалося відкрити " + path);
+        struct stat st;
+        fstat(fd, &st);
+        length = (size_t)st.st_size;
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED)
+            throw runtime_error("Не вдалося відобразити " + path);
+        data = (const char*)p;
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap((void*)data, length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data; }
+    size_t size() const { return length; }
+};
+
+// === Бінарний знімок компанії ===
+// Колонки записуються у файл у тому ж вигляді, що й у пам'яті, тому відображений
+// знімок одразу придатний для читання без розбору. toCompany() лише копіює
+// колонки блоками, коли потрібні Visitor-API і зміни структури.
+class CompanySnapshot {
+    struct Header {
+        char magic[8];
+        uint64_t employeeCount;
+        uint64_t departmentCount;
+        uint64_t positionCount;
+        uint64_t salariesOffset;     // double[employeeCount]
+        uint64_t positionIdsOffset;  // uint32_t[employeeCount]
+        uint64_t employeeIdsOffset;  // uint32_t[employeeCount]
+        uint64_t departmentsOffset;  // DepartmentEntry[departmentCount]
+        uint64_t positionsOffset;    // StringRef[positionCount]
+        uint64_t nameOffset;         // StringRef назви компанії
+    };
+
+    struct StringRef {
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    struct DepartmentEntry {
+        uint32_t begin;
+        uint32_t count;
+        double totalSalary;
+        StringRef name;
+    };
+
+    static constexpr char MAGIC[8] = {'O', 'R', 'G', 'S', 'N', 'A', 'P', '1'};
+
+    MappedFile file;
+    const Header* header;
+
+    template <typename T>
+    const T* at(uint64_t offset) const { return reinterpret_cast<const T*>(file.begin() + offset); }
+
+    // Масив T[count] за зсувом offset повністю лежить у файлі і вирівняний
+    template <typename T>
+    bool fits(uint64_t offset, uint64_t count) const {
+        return offset % alignof(T) == 0 && offset <= file.size() && count <= (file.size() - offset) / sizeof(T);
+    }
+
+    bool fits(const StringRef& ref) const { return ref.offset <= file.size() && ref.length <= file.size() - ref.offset; }
+
+    // Заголовок і таблиці перевіряються один раз, щоб далі читати без перевірок
+    void validate(const string& path) const {
+        auto corrupt = [&](const char* what) {
+            return runtime_error("Знімок " + path + " пошкоджено: " + what);
+        };
+        const Header& h = *header;
+        if (h.employeeCount > UINT32_MAX || h.departmentCount > UINT32_MAX)
+            throw corrupt("завеликі лічильники");
+        if (!fits<double>(h.salariesOffset, h.employeeCount) || !fits<uint32_t>(h.positionIdsOffset, h.employeeCount)
+            || !fits<uint32_t>(h.employeeIdsOffset, h.employeeCount)
+            || !fits<DepartmentEntry>(h.departmentsOffset, h.departmentCount)
+            || !fits<StringRef>(h.positionsOffset, h.positionCount) || !fits<StringRef>(h.nameOffset, 1))
+            throw corrupt("таблиця виходить за межі файлу");
+        if (!fits(*at<StringRef>(h.nameOffset)))
+            throw corrupt("назва компанії виходить за межі файлу");
+        const StringRef* positions = at<StringRef>(h.positionsOffset);
+        for (uint64_t p = 0; p < h.positionCount; ++p)
+            if (!fits(positions[p]))
+                throw corrupt("назва посади виходить за межі файлу");
+        // Департаменти йдуть поспіль і разом покривають усіх співробітників
+        const DepartmentEntry* deps = at<DepartmentEntry>(h.departmentsOffset);
+        uint64_t next = 0;
+        for (uint64_t d = 0; d < h.departmentCount; ++d) {
+            if (deps[d].begin != next || deps[d].count > h.employeeCount - next || !fits(deps[d].name))
+                throw corrupt("некоректний запис департаменту");
+            next += deps[d].count;
+        }
+        if (next != h.employeeCount)
+            throw corrupt("департаменти не покривають усіх співробітників");
+    }
+
+    static size_t align8(string& out) {
+        out.resize((out.size() + 7) & ~size_t(7), '\0');
+        return out.size();
+    }
+
+    template <typename T>
+    static uint64_t appendArray(string& out, const T* items, size_t count) {
+        size_t offset = align8(out);
+        out.append(reinterpret_cast<const char*>(items), count * sizeof(T));
+        return offset;
+    }
+
+    static StringRef appendString(string& strings, const string& s) {
+        StringRef ref{strings.size(), s.size()};
+        strings += s;
+        return ref;
+    }
+
+public:
+    explicit CompanySnapshot(const string& path) : file(path) {
+        header = at<Header>(0);
+        if (file.size() < sizeof(Header) || !equal(header->magic, header->magic + 8, MAGIC))
+            throw runtime_error("Файл " + path + " не є знімком компанії");
+        validate(path);
+    }
+
+    static void write(const Company& c, const string& path) {
+        Header h{};
+        copy(MAGIC, MAGIC + 8, h.magic);
+        h.employeeCount = c.salaries.size();
+        h.departmentCount = c.departments.size();
+        h.positionCount = c.positionNames.size();
+
+        string body(sizeof(Header), '\0'), strings;
+        vector<DepartmentEntry> deps;
+        for (auto& d : c.departments)
+            deps.push_back({d.begin, d.count, d.totalSalary, appendString(strings, d.getName())});
+        vector<StringRef> positions;
+        for (auto& p : c.positionNames)
+            positions.push_back(appendString(strings, p));
+        StringRef name = appendString(strings, c.name);
+
+        h.salariesOffset = appendArray(body, c.salaries.data(), c.salaries.size());
+        h.positionIdsOffset = appendArray(body, c.positionIds.data(), c.positionIds.size());
+        h.employeeIdsOffset = appendArray(body, c.employeeIds.data(), c.employeeIds.size());
+        h.departmentsOffset = appendArray(body, deps.data(), deps.size());
+        h.positionsOffset = appendArray(body, positions.data(), positions.size());
+        // Рядки йдуть у кінці; зсуви в StringRef відраховуються від stringsStart
+        uint64_t stringsStart = align8(body);
+        body += strings;
+        h.nameOffset = appendArray(body, &name, 1);
+
+        // Переводимо зсуви рядків у абсолютні
+        auto fix = [&](uint64_t tableOffset, size_t count, size_t stride, size_t refOffset) {
+            for (size_t i = 0; i < count; ++i) {
+                StringRef* ref = reinterpret_cast<StringRef*>(&body[tableOffset + i * stride + refOffset]);
+                ref->offset += stringsStart;
+            }
+        };
+        fix(h.departmentsOffset, deps.size(), sizeof(DepartmentEntry), offsetof(DepartmentEntry, name));
+        fix(h.positionsOffset, positions.size(), sizeof(StringRef), 0);
+        fix(h.nameOffset, 1, sizeof(StringRef), 0);
+
+        memcpy(&body[0], &h, sizeof(Header));
+        ofstream out(path, ios::binary);
+        out.write(body.data(), body.size());
+        if (!out)
+            throw runtime_error("Не вдалося записати знімок " + path);
+    }
+
+    // === Читання напряму з відображеного файлу ===
+    size_t getEmployeeCount() const { return header->employeeCount; }
+    size_t getDepartmentCount() const { return header->departmentCount; }
+
+    string getName() const {
+        const StringRef& ref = *at<StringRef>(header->nameOffset);
+        return string(file.begin() + ref.offset, ref.length);
+    }
+
+    string getDepartmentName(size_t d) const {
+        const StringRef& ref = at<DepartmentEntry>(header->departmentsOffset)[d].name;
+        return string(file.begin() + ref.offset, ref.length);
+    }
+
+    double getDepartmentTotal(size_t d) const { return at<DepartmentEntry>(header->departmentsOffset)[d].totalSalary; }
+
+    Span<const double> getSalaries() const { return {at<double>(header->salariesOffset), header->employeeCount}; }
+
+    Span<const double> getDepartmentSalaries(size_t d) const {
+        const DepartmentEntry& dep = at<DepartmentEntry>(header->departmentsOffset)[d];
+        return {at<double>(header->salariesOffset) + dep.begin, dep.count};
+    }
+
+    // Повна змінювана компанія для Visitor-API: колонки копіюються блоками
+    unique_ptr<Company> toCompany() const {
+        unique_ptr<Company> company(new Company(getName()));
+        Company& c = *company;
+        size_t n = header->employeeCount;
+        c.salaries.assign(at<double>(header->salariesOffset), at<double>(header->salariesOffset) + n);
+        c.positionIds.assign(at<uint32_t>(header->positionIdsOffset), at<uint32_t>(header->positionIdsOffset) + n);
+        c.employeeIds.assign(at<uint32_t>(header->employeeIdsOffset), at<uint32_t>(header->employeeIdsOffset) + n);
+        for (uint32_t position : c.positionIds)
+            if (position >= header->positionCount)
+                throw runtime_error("Знімок пошкоджено: посада поза таблицею посад");
+        uint32_t maxId = 0;
+        for (uint32_t id : c.employeeIds) {
+            if (id == Company::NO_SLOT)
+                throw runtime_error("Знімок пошкоджено: некоректний id співробітника");
+            maxId = max(maxId, id + 1);
+        }
+        c.slotOfId.assign(maxId, Company::NO_SLOT);
+        for (uint32_t slot = 0; slot < n; ++slot) {
+            if (c.slotOfId[c.employeeIds[slot]] != Company::NO_SLOT)
+                throw runtime_error("Знімок пошкоджено: повторний id співробітника");
+            c.slotOfId[c.employeeIds[slot]] = slot;
+        }
+
+        const StringRef* positions = at<StringRef>(header->positionsOffset);
+        for (size_t p = 0; p < header->positionCount; ++p)
+            c.internPosition(string(file.begin() + positions[p].offset, positions[p].length));
+
+        c.employees.reserve(n);
+        for (uint32_t i = 0; i < n; ++i)
+            c.employees.emplace_back(&c, i);
+        const DepartmentEntry* deps = at<DepartmentEntry>(header->departmentsOffset);
+        for (uint32_t d = 0; d < header->departmentCount; ++d) {
+            c.departmentNames.push_back(getDepartmentName(d));
+            c.departments.emplace_back(&c, d, deps[d].begin, deps[d].count);
+        }
+        c.recomputeAggregates();
+        return company;
+    }
+};
+
+// === Піковий обсяг пам'яті процесу, МБ ===
+double peakMemoryMb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    return 0;
+#else
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return stod(line.substr(6)) / 1024.0; // значення в кБ
+    return 0;
+#endif
+}
+
+// === Перевірка інкрементних агрегатів повним обходом ===
+bool verifyAggregates(Company& company) {
+    ostringstream discard;
+    SalaryReportVisitor visitor(discard);
+    company.accept(&visitor);
+
+    auto close = [](double a, double b) { return fabs(a - b) <= 1e-6 * max(1.0, fabs(b)); };
+    Span<Department> departments = company.getDepartments();
+    for (size_t d = 0; d < departments.size(); ++d)
+        if (!close(departments[d].getTotalSalary(), visitor.getDepartmentTotals()[d]))
+            return false;
+    return close(company.getTotalSalary(), visitor.getTotalCompanySalary());
+}
+
+// === Синтетична компанія для вимірювань ===
+unique_ptr<Company> buildSyntheticCompany(size_t employees, size_t departments) {
+    static const char* positions[] = {"Менеджер", "Аналітик", "Програміст", "Тестувальник", "Дизайнер"};
+    CompanyBuilder builder("SyntheticCorp");
+    for (size_t d = 0; d < departments; ++d)
+        builder.addDepartment("Департамент " + to_string(d));
+    builder.reserve(employees);
+    for (size_t i = 0; i < employees; ++i)
+        builder.addEmployee(i % departments, positions[i % 5], 15000 + (i * 37) % 40000);
+    return builder.build();
+}
+
+// Записує CSV-вивантаження з employees рядками
+void writeSyntheticCsv(const string& path, size_t employees, size_t departments) {
+    static const char* positions[] = {"Менеджер", "Аналітик", "Програміст", "Тестувальник", "Дизайнер"};
+    ofstream out(path, ios::binary);
+    out << "department,position,salary\n";
+    string line;
+    for (size_t i = 0; i < employees; ++i) {
+        line = "Департамент " + to_string(i % departments) + "," + positions[i % 5] + ","
+             + to_string(15000 + (i * 37) % 40000) + "\n";
+        out << line;
+    }
+    // Кілька пошкоджених рядків: завантажувач має їх відкинути і порахувати
+    out << "Департамент 0,Менеджер\n"
+           "Департамент 1,Аналітик,н/д\n";
+}
+
+// === Завантаження в окремому процесі ===
+// Пікова пам'ять — показник усього процесу, тому кожен завантажувач запускається
+// в новому процесі цієї ж програми: "--load csv CSV ЗНІМОК" або "--load snapshot ЗНІМОК".
+int runLoadStage(const string& mode, const string& path, const string& snapshotPath) {
+    auto start = chrono::steady_clock::now();
+    auto elapsedMs = [&] { return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); };
+    if (mode == "csv") {
+        WorkStealingPool pool;
+        CsvCompanyLoader loader(pool);
+        unique_ptr<Company> loaded = loader.load(path, "LoadedCorp");
+        double ms = elapsedMs();
+        cout << "CSV: " << loaded->getEmployeeCount() << " співробітників за " << ms << " мс, відкинуто рядків "
+             << loader.getBadRowCount() << ", пікова пам'ять " << peakMemoryMb() << " МБ" << endl;
+        CompanySnapshot::write(*loaded, snapshotPath);
+        return 0;
+    }
+    if (mode == "snapshot") {
+        CompanySnapshot snapshot(path);
+        double total = 0;
+        for (size_t d = 0; d < snapshot.getDepartmentCount(); ++d)
+            total += snapshot.getDepartmentTotal(d);
+        double ms = elapsedMs();
+        cout << "Знімок (відображення в пам'ять): " << snapshot.getEmployeeCount() << " співробітників, фонд "
+             << total << " грн за " << ms << " мс, пікова пам'ять " << peakMemoryMb() << " МБ\n";
+
+        start = chrono::steady_clock::now();
+        unique_ptr<Company> restored = snapshot.toCompany();
+        ms = elapsedMs();
+        cout << "Знімок -> Company: " << ms << " мс, перевірка обходом: "
+             << (verifyAggregates(*restored) ? "OK" : "РОЗБІЖНІСТЬ") << ", пікова пам'ять "
+             << peakMemoryMb() << " МБ" << endl;
+        return 0;
+    }
+    cerr << "Невідомий режим завантаження: " << mode << "\n";
+    return 2;
+}
+
+// Запускає цю ж програму з аргументами args без командної оболонки, тож пробіли
+// в шляхах не ламають виклик; false — процес не запустився або завершився з помилкою.
+// argv0 — argv[0] поточного процесу: передається дочірньому як є, а там, де немає
+// /proc/self/exe, за ним шукається сам виконуваний файл (execvp враховує PATH).
+bool runIsolated(const char* argv0, const vector<string>& args) {
+    cout.flush();
+#ifdef _WIN32
+    char self[MAX_PATH];
+    DWORD length = GetModuleFileNameA(nullptr, self, MAX_PATH);
+    if (length == 0 || length == MAX_PATH)
+        return false;
+    string command = "\"" + string(self) + "\"";
+    for (auto& arg : args)
+        command += " \"" + arg + "\"";
+    STARTUPINFOA startup{};
+    startup.cb = sizeof startup;
+    PROCESS_INFORMATION process{};
+    if (!CreateProcessA(nullptr, &command[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &process))
+        return false;
+    WaitForSingleObject(process.hProcess, INFINITE);
+    DWORD exitCode = 1;
+    GetExitCodeProcess(process.hProcess, &exitCode);
+    CloseHandle(process.hThread);
+    CloseHandle(process.hProcess);
+    return exitCode == 0;
+#else
+    const char* self = access("/proc/self/exe", X_OK) == 0 ? "/proc/self/exe" : argv0;
+    // Вектор аргументів готується до fork: у дочірньому процесі — лише exec і _exit
+    vector<char*> childArgv;
+    childArgv.push_back(const_cast<char*>(argv0));
+    for (auto& arg : args)
+        childArgv.push_back(const_cast<char*>(arg.c_str()));
+    childArgv.push_back(nullptr);
+    pid_t pid = fork();
+    if (pid < 0)
+        return false;
+    if (pid == 0) {
+        execvp(self, childArgv.data());
+        _exit(127);
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR)
+            return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+// === Клієнтський код ===
+// Аргумент (необов'язковий) — кількість співробітників для вимірювання завантаження,
+// наприклад 10000000; за замовчуванням 1000000.
+int main(int argc, char** argv) {
+#ifdef _WIN32
+    SetConsoleOutputCP(65001);
+#endif
+    if (argc >= 4 && string(argv[1]) == "--load") {
+        try {
+            return runLoadStage(argv[2], argv[3], argc > 4 ? argv[4] : "");
+        } catch (const exception& e) {
+            cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    // Створюємо компанію з департаментами і співробітниками
+    CompanyBuilder builder("TechCorp");
+    size_t sales = builder.addDepartment("Відділ Продажів");
+    size_t it = builder.addDepartment("IT Відділ");
+
+    builder.addEmployee(sales, "Менеджер", 25000);
+    builder.addEmployee(sales, "Аналітик", 20000);
+    builder.addEmployee(it, "Програміст", 30000);
+    builder.addEmployee(it, "Тестувальник", 22000);
+
+    unique_ptr<Company> company = builder.build();
+    Department& d2 = company->getDepartments()[it];
+
+    // Створюємо відвідувача
+    SalaryReportVisitor reportVisitor;
+
+    // Формуємо звіт для всієї компанії
+    company->accept(&reportVisitor);
+
+    // Формуємо звіт тільки для одного департаменту
+    cout << "\n\n===== Звіт тільки для одного департаменту =====\n";
+    d2.accept(&reportVisitor);
+
+    // Інкрементні агрегати: звіт без обходу співробітників
+    cout << "\n\n===== Зміни в компанії та зведення =====\n";
+    uint32_t designer = company->hire(it, "Дизайнер", 27000);
+    company->changeSalary(designer, 28000);
+    Span<Employee> salesStaff = company->getDepartments()[sales].getEmployees();
+    uint32_t manager = salesStaff[0].getId();
+    uint32_t analyst = salesStaff[1].getId();
+    company->moveEmployee(analyst, it);
+    company->fire(manager);
+    size_t missingDepartment = company->getDepartments().size();
+    unique_ptr<Company> empty = CompanyBuilder("Без департаментів").build();
+    bool rejected = true;
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        try {
+            if (attempt == 0)
+                company->hire(missingDepartment, "Стажер", 10000);
+            else if (attempt == 1)
+                company->moveEmployee(designer, missingDepartment);
+            else
+                empty->hire(0, "Стажер", 10000);
+            rejected = false;
+        } catch (const out_of_range&) {
+        }
+    }
+    cout << "Неіснуючий департамент відхилено (і в компанії без департаментів): "
+         << (rejected ? "так" : "НІ") << "\n";
+    for (auto& dep : company->getDepartments())
+        cout << dep.getName() << ": " << dep.getEmployeeCount() << " співробітників, "
+             << dep.getTotalSalary() << " грн\n";
+    cout << "Разом: " << company->getEmployeeCount() << " співробітників, "
+         << company->getTotalSalary() << " грн | перевірка обходом: "
+         << (verifyAggregates(*company) ? "OK" : "РОЗБІЖНІСТЬ") << "\n";
+
+    // Паралельний обхід: масштабування від 1 до N потоків на мільйоні співробітників
+    cout << "\n\n===== Паралельна зарплатна відомість =====\n";
+    unique_ptr<Company> synthetic = buildSyntheticCompany(1000000, 200);
+    ostringstream sequentialReport;
+    SalaryReportVisitor sequential(sequentialReport);
+    auto start = chrono::steady_clock::now();
+    synthetic->accept(&sequential);
+    double sequentialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Послідовно: " << sequentialMs << " мс\n";
+
+    size_t maxThreads = max<size_t>(thread::hardware_concurrency(), 1);
+    for (size_t threads = 1; ; threads = min(threads * 2, maxThreads)) {
+        WorkStealingPool pool(threads);
+        ostringstream parallelReport;
+        ParallelSalaryReportVisitor parallel(pool, parallelReport);
+        start = chrono::steady_clock::now();
+        synthetic->accept(&parallel);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "Потоків: " << threads << " | " << ms << " мс | звіт "
+             << (parallelReport.str() == sequentialReport.str() ? "збігається" : "ВІДРІЗНЯЄТЬСЯ") << "\n";
+        if (threads == maxThreads)
+            break;
+    }
+
+    // Зведена аналітика за один обхід проти окремого відвідувача на кожну метрику
+    cout << "\n\n===== Зведена аналітика vs окремі відвідувачі =====\n";
+    SalaryAnalyticsVisitor analytics;
+    company->accept(&analytics);
+    analytics.print(cout);
+
+    start = chrono::steady_clock::now();
+    synthetic->accept(&analytics);
+    double fusedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    const SalaryMetric metrics[] = {SalaryMetric::Count, SalaryMetric::Sum, SalaryMetric::Min, SalaryMetric::Max,
+                                    SalaryMetric::Mean, SalaryMetric::P50, SalaryMetric::P90, SalaryMetric::P99};
+    double separateMs = 0, exactP50 = 0, exactP99 = 0;
+    start = chrono::steady_clock::now();
+    for (SalaryMetric metric : metrics) {
+        SingleMetricVisitor single(metric);
+        synthetic->accept(&single);
+        if (metric == SalaryMetric::P50) exactP50 = single.getCompanyResult();
+        if (metric == SalaryMetric::P99) exactP99 = single.getCompanyResult();
+    }
+    separateMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    const SalaryStats& totals = analytics.getTotals();
+    cout << "Один обхід: " << fusedMs << " мс | " << size(metrics) << " окремих відвідувачів: " << separateMs
+         << " мс | прискорення x" << separateMs / fusedMs << "\n";
+    cout << "p50: скетч " << totals.quantile(0.5) << " / точно " << exactP50
+         << " | p99: скетч " << totals.quantile(0.99) << " / точно " << exactP99 << "\n";
+
+    // Статичне відвідування: результат повертається, а не накопичується у відвідувачі
+    cout << "\n\n===== Статичне відвідування =====\n";
+    auto describe = Overloaded{
+        [](Company& c) { return "Компанія " + c.getName(); },
+        [](Department& d) { return "Департамент " + d.getName(); },
+        [](Employee& e) { return e.getPosition() + " #" + to_string(e.getId()); },
+    };
+    for (const OrgNode& node : flattenNodes(*company))
+        cout << visitNode(node, describe) << "\n";
+    for (auto& dep : company->getDepartments())
+        cout << dep.getName() << ": "
+             << reduceEmployees(dep, [](Employee& e) { return e.getSalary(); }) << " грн\n";
+    // walk(*company, [](Employee& e) {});  // не компілюється: немає обробників Company і Department
+
+    // Вузлів за секунду: класичний accept/visit, статичний обхід і variant
+    auto nodesPerSec = [](size_t nodes, chrono::steady_clock::time_point from) {
+        return nodes / chrono::duration<double>(chrono::steady_clock::now() - from).count();
+    };
+    SalaryTotalVisitor classic;
+    start = chrono::steady_clock::now();
+    synthetic->accept(&classic);
+    double classicRate = nodesPerSec(classic.getNodeCount(), start);
+
+    double staticTotal = 0;
+    size_t staticNodes = 0;
+    start = chrono::steady_clock::now();
+    walk(*synthetic, Overloaded{
+        [&](Company&) { ++staticNodes; },
+        [&](Department&) { ++staticNodes; },
+        [&](Employee& e) { ++staticNodes; staticTotal += e.getSalary(); },
+    });
+    double staticRate = nodesPerSec(staticNodes, start);
+
+    vector<OrgNode> syntheticNodes = flattenNodes(*synthetic);
+    double variantTotal = 0;
+    start = chrono::steady_clock::now();
+    auto salaryOf = Overloaded{
+        [](Company&) { return 0.0; },
+        [](Department&) { return 0.0; },
+        [](Employee& e) { return e.getSalary(); },
+    };
+    for (const OrgNode& node : syntheticNodes)
+        variantTotal += visitNode(node, salaryOf);
+    double variantRate = nodesPerSec(syntheticNodes.size(), start);
+    syntheticNodes.clear();
+    syntheticNodes.shrink_to_fit();
+
+    cout << "Visitor (accept/visit): " << classicRate / 1e6 << " млн вузлів/с\n"
+         << "Статичний обхід:       " << staticRate / 1e6 << " млн вузлів/с\n"
+         << "variant по списку:     " << variantRate / 1e6 << " млн вузлів/с\n"
+         << "Суми збігаються: "
+         << (classic.getTotal() == staticTotal && staticTotal == variantTotal ? "так" : "НІ") << "\n";
+
+    // Зміни структури на мільйоні співробітників: O(кількість департаментів) на операцію
+    const int moves = 100000;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < moves; ++i) {
+        uint32_t id = synthetic->hire((size_t)i % 200, "Стажист", 20000);
+        synthetic->moveEmployee(id, (size_t)(i * 7) % 200);
+        synthetic->fire(id);
+    }
+    double mutationNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (3.0 * moves);
+    cout << "hire/moveEmployee/fire: " << mutationNs << " нс на операцію, перевірка обходом: "
+         << (verifyAggregates(*synthetic) ? "OK" : "РОЗБІЖНІСТЬ") << "\n";
+
+    // Потокове завантаження з CSV і бінарний знімок
+    size_t loadSize = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    cout << "\n\n===== Завантаження " << loadSize << " співробітників =====\n";
+    synthetic.reset();
+    const filesystem::path tempDir = filesystem::temp_directory_path();
+    const string csvPath = (tempDir / "lab9_org_export.csv").string();
+    const string snapshotPath = (tempDir / "lab9_org.snapshot").string();
+    // Тимчасові файли видаляються за будь-якого виходу з блоку, зокрема через виняток
+    struct TempFiles {
+        vector<string> paths;
+        ~TempFiles() {
+            error_code ignored;
+            for (auto& path : paths)
+                filesystem::remove(path, ignored);
+        }
+    } tempFiles{{csvPath, snapshotPath}};
+    try {
+        writeSyntheticCsv(csvPath, loadSize, 200);
+        // Кожен завантажувач — в окремому процесі, щоб пікова пам'ять належала лише йому
+        if (!runIsolated(argv[0], {"--load", "csv", csvPath, snapshotPath})
+            || !runIsolated(argv[0], {"--load", "snapshot", snapshotPath}))
+            cout << "Не вдалося виконати завантаження в окремому процесі\n";
+
+        // Пошкоджений знімок відхиляється до будь-якого читання
+        ifstream in(snapshotPath, ios::binary);
+        string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        in.close();
+        ofstream(snapshotPath, ios::binary | ios::trunc).write(bytes.data(), (streamsize)(bytes.size() / 2));
+        try {
+            CompanySnapshot truncated(snapshotPath);
+            cout << "Обрізаний знімок прийнято — ПОМИЛКА\n";
+        } catch (const runtime_error& e) {
+            cout << "Обрізаний знімок відхилено: " << e.what() << "\n";
+        }
+    } catch (const exception& e) {
+        cout << "Помилка завантаження: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../common/alloc_counter.h"
+#include "../common/telemetry.h"
+#include "bench.h"
+
+using namespace std;
+
+// Лічильник виділень пам'яті для всього процесу (оператори new/delete — з common/alloc_counter.h)
+size_t benchAllocationCount() { return alloc_counter::allocationCount(); }
+
+// === Порожній буфер: консольний вивід форматується, але нікуди не пишеться ===
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+// Журнал лабораторних (якщо ввімкнено --log-level) форматується, але відкидається.
+// Глобальний, щоб пережити фоновий вивід телеметрії під час завершення програми.
+static NullBuffer logBuffer;
+static ostream logSink(&logBuffer);
+
+struct BenchResult {
+    string lab;
+    string name;
+    size_t operations = 0;
+    size_t batch = 0;
+    double seconds = 0;
+    // Нс на операцію: перцентилі середнього часу операції в пакеті з batch
+    // операцій; при batch = 1 — перцентилі окремих операцій
+    double p50 = 0, p90 = 0, p99 = 0;
+    double allocationsPerOp = 0;
+};
+
+// Операції виконуються пакетами, час пакета ділиться на його розмір.
+// Розмір пакета підбирається так, щоб пакет тривав щонайменше ~20 мкс
+// (точність годинника), тому перцентилі — це перцентилі середнього
+// часу операції в пакеті. Повільні операції (від 20 мкс) вимірюються
+// поодинці (batch = 1), і тоді кожен зразок — час однієї операції.
+static BenchResult runCase(const BenchCase& benchCase, double minSeconds) {
+    using clock = chrono::steady_clock;
+    BenchResult result;
+    result.lab = benchCase.lab;
+    result.name = benchCase.name;
+
+    BenchCase::Operation op = benchCase.setup();
+    auto timeBatch = [&](size_t count) {
+        auto start = clock::now();
+        for (size_t i = 0; i < count; ++i)
+            op();
+        return chrono::duration<double>(clock::now() - start).count();
+    };
+
+    size_t batch = 1;
+    while (timeBatch(batch) < 20e-6 && batch < (size_t(1) << 24))
+        batch *= 2;
+
+    vector<double> samples;
+    size_t allocationsBefore = benchAllocationCount();
+    auto start = clock::now();
+    double elapsed = 0;
+    while (elapsed < minSeconds || samples.size() < 10) {
+        samples.push_back(timeBatch(batch) * 1e9 / batch);
+        result.operations += batch;
+        elapsed = chrono::duration<double>(clock::now() - start).count();
+    }
+    result.allocationsPerOp = double(benchAllocationCount() - allocationsBefore) / result.operations;
+    result.seconds = elapsed;
+    result.batch = batch;
+
+    sort(samples.begin(), samples.end());
+    auto percentile = [&](double q) { return samples[size_t(q * (samples.size() - 1))]; };
+    result.p50 = percentile(0.5);
+    result.p90 = percentile(0.9);
+    result.p99 = percentile(0.99);
+    return result;
+}
+
+static string jsonEscape(const string& s) {
+    string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if ((unsigned char)c < 0x20) {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", c);
+            out += code;
+            continue;
+        }
+        out += c;
+    }
+    return out;
+}
+
+static void writeJson(ostream& out, const vector<BenchResult>& results) {
+    out << "{\n  \"version\": 2,\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"lab\": \"" << jsonEscape(r.lab) << "\", \"name\": \"" << jsonEscape(r.name)
+            << "\", \"operations\": " << r.operations << ", \"batch\": " << r.batch
+            << ", \"percentiles_of\": \"" << (r.batch == 1 ? "operation" : "batch_mean") << "\""
+            << ", \"ops_per_sec\": " << r.operations / r.seconds << ", \"p50_ns\": " << r.p50
+            << ", \"p90_ns\": " << r.p90 << ", \"p99_ns\": " << r.p99
+            << ", \"allocs_per_op\": " << r.allocationsPerOp << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+static void usage() {
+    cerr << "Використання: labs_bench [--filter ТЕКСТ] [--min-time СЕКУНДИ] [--json ФАЙЛ] [--list]\n"
+            "                  [--log-level off|error|info|debug] [--timing]\n";
+}
+
+int main(int argc, char** argv) {
+    string filter, jsonPath;
+    double minSeconds = 0.2;
+    bool listOnly = false;
+    // За замовчуванням вимірюється гарячий шлях із вимкненими журналом і відрізками телеметрії
+    telemetry::LogLevel logLevel = telemetry::LogLevel::Off;
+    bool timing = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc)
+            minSeconds = atof(argv[++i]);
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (arg == "--log-level" && i + 1 < argc && telemetry::parseLevel(argv[i + 1], logLevel))
+            ++i;
+        else if (arg == "--timing")
+            timing = true;
+        else if (arg == "--list")
+            listOnly = true;
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    telemetry::Telemetry::instance().setSink(logSink);
+    telemetry::setLevel(logLevel);
+    telemetry::setTiming(timing);
+
+    BenchRegistry registry;
+    registerLab1(registry);
+    registerLab2(registry);
+    registerLab3(registry);
+    registerLab4(registry);
+    registerLab5(registry);
+    registerLab6(registry);
+    registerLab7(registry);
+    registerLab8(registry);
+    registerLab9(registry);
+    registerLab10(registry);
+
+    NullBuffer nullBuffer;
+    vector<BenchResult> results;
+    cout << left << setw(6) << "lab" << " " << setw(52) << "case" << right << setw(14) << "ops/s"
+         << setw(9) << "batch" << setw(12) << "p50 ns*" << setw(12) << "p90 ns*" << setw(12) << "p99 ns*"
+         << setw(12) << "allocs/op" << "\n";
+    for (const BenchCase& benchCase : registry.all()) {
+        string fullName = benchCase.lab + " " + benchCase.name;
+        if (!filter.empty() && fullName.find(filter) == string::npos)
+            continue;
+        if (listOnly) {
+            cout << fullName << "\n";
+            continue;
+        }
+
+        // Програми лабораторних пишуть у cout; під час вимірювання вивід відкидається
+        streambuf* console = cout.rdbuf(&nullBuffer);
+        BenchResult r = runCase(benchCase, minSeconds);
+        cout.rdbuf(console);
+
+        results.push_back(r);
+        cout << left << setw(6) << r.lab << " " << setw(52) << r.name << right << fixed << setprecision(0)
+             << setw(14) << r.operations / r.seconds << setw(9) << r.batch
+             << setprecision(1) << setw(12) << r.p50 << setw(12) << r.p90
+             << setw(12) << r.p99 << setprecision(2) << setw(12) << r.allocationsPerOp << "\n";
+        cout.unsetf(ios::floatfield);
+        cout << setprecision(6);
+    }
+
+    if (!listOnly)
+        cout << "* перцентилі середнього часу операції в пакеті з batch операцій; при batch = 1 — окремих операцій\n";
+
+    if (!jsonPath.empty()) {
+        ofstream json(jsonPath);
+        writeJson(json, results);
+        if (!json) {
+            cerr << "Не вдалося записати " << jsonPath << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// === Спільний каркас бенчмарка гарячих шляхів лабораторних ===
+
+// Кількість викликів operator new у процесі (рахує bench.cpp)
+size_t benchAllocationCount();
+
+// Сюди записуються результати операцій, щоб компілятор не викинув обчислення
+inline volatile size_t benchSink = 0;
+
+// Вимірюваний гарячий шлях: setup готує стан і повертає одну операцію,
+// яка потім викликається багато разів
+struct BenchCase {
+    using Operation = std::function<void()>;
+
+    std::string lab;
+    std::string name;
+    std::function<Operation()> setup;
+};
+
+class BenchRegistry {
+    std::vector<BenchCase> cases;
+
+public:
+    void add(std::string lab, std::string name, std::function<BenchCase::Operation()> setup) {
+        cases.push_back({std::move(lab), std::move(name), std::move(setup)});
+    }
+
+    const std::vector<BenchCase>& all() const { return cases; }
+};
+
+// Реєстрація бенчмарків кожної лабораторної (bench/labN_bench.cpp)
+void registerLab1(BenchRegistry& registry);
+void registerLab2(BenchRegistry& registry);
+void registerLab3(BenchRegistry& registry);
+void registerLab4(BenchRegistry& registry);
+void registerLab5(BenchRegistry& registry);
+void registerLab6(BenchRegistry& registry);
+void registerLab7(BenchRegistry& registry);
+void registerLab8(BenchRegistry& registry);
+void registerLab9(BenchRegistry& registry);
+void registerLab10(BenchRegistry& registry);
@@ -0,0 +1,45 @@
+#include "lab_prelude.h"
+
+namespace lab10 {
+#include "../Lab10/main.cpp"
+}
+
+namespace {
+// Форма з шістьма компонентами і посередником
+struct Form {
+    lab10::DeliveryDatePicker date;
+    lab10::TimeSlotSelector timeSlots;
+    lab10::OtherPersonCheckbox otherPerson;
+    lab10::RecipientNameField nameField;
+    lab10::RecipientPhoneField phoneField;
+    lab10::PickupCheckbox pickup;
+    lab10::OrderFormMediator mediator{&date, &timeSlots, &otherPerson, &nameField, &phoneField, &pickup};
+
+    Form() { mediator.setVerbose(false); }
+};
+}
+
+void registerLab10(BenchRegistry& registry) {
+    registry.add("Lab10", "Mediator::notify (interned ids)", [] {
+        auto form = std::make_shared<Form>();
+        lab10::EventId sender = form->mediator.senderId("OtherPersonCheckbox");
+        lab10::EventId toggled = form->mediator.eventId("Toggled");
+        return [form, sender, toggled] { form->mediator.notify(sender, toggled); };
+    });
+    registry.add("Lab10", "Mediator::notify (strings)", [] {
+        auto form = std::make_shared<Form>();
+        return [form] { form->mediator.notify("OtherPersonCheckbox", "Toggled"); };
+    });
+    registry.add("Lab10", "Form burst of 5 events (batched)", [] {
+        auto form = std::make_shared<Form>();
+        auto today = std::make_shared<std::string>("Сьогодні");
+        return [form, today] {
+            lab10::FormBatch batch(form->mediator);
+            form->date.selectDate(*today);
+            form->otherPerson.toggle(true);
+            form->pickup.toggle(true);
+            form->pickup.toggle(false);
+            form->otherPerson.toggle(false);
+        };
+    });
+}
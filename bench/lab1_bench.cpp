@@ -0,0 +1,20 @@
+#include "lab_prelude.h"
+
+namespace lab1 {
+#include "../Lab1/main.cpp"
+}
+
+void registerLab1(BenchRegistry& registry) {
+    registry.add("Lab1", "StorageManager::upload (LocalDisk)", [] {
+        auto storage = std::make_shared<lab1::LocalDiskStorage>();
+        lab1::StorageManager* manager = lab1::StorageManager::getInstance();
+        manager->setStorage(storage.get());
+        return [storage, manager] { manager->upload("document.txt"); };
+    });
+    registry.add("Lab1", "StorageManager::upload (AmazonS3)", [] {
+        auto storage = std::make_shared<lab1::AmazonS3Storage>();
+        lab1::StorageManager* manager = lab1::StorageManager::getInstance();
+        manager->setStorage(storage.get());
+        return [storage, manager] { manager->upload("report.pdf"); };
+    });
+}
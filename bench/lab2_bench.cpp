@@ -0,0 +1,16 @@
+#include "lab_prelude.h"
+
+namespace lab2 {
+#include "../Lab2/main.cpp"
+}
+
+void registerLab2(BenchRegistry& registry) {
+    registry.add("Lab2", "FacebookCreator::createNetwork + publishMessage", [] {
+        auto creator = std::make_shared<lab2::FacebookCreator>();
+        return [creator] {
+            lab2::SocialNetwork* network = creator->createNetwork("nikita_user", "12345");
+            network->publishMessage("Hello, it`s my first post on Facebook!");
+            delete network;
+        };
+    });
+}
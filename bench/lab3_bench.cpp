@@ -0,0 +1,22 @@
+#include "lab_prelude.h"
+
+namespace lab3 {
+#include "../Lab3/main.cpp"
+}
+
+void registerLab3(BenchRegistry& registry) {
+    registry.add("Lab3", "PostgreSQL select/where/limit/getSQL", [] {
+        auto builder = std::make_shared<lab3::PostgreSQLQueryBuilder>();
+        return [builder] {
+            std::string sql = builder->select("*")->where("age > 18")->limit(10)->getSQL();
+            benchSink = sql.size();
+        };
+    });
+    registry.add("Lab3", "MySQL select/where/limit/getSQL", [] {
+        auto builder = std::make_shared<lab3::MySQLQueryBuilder>();
+        return [builder] {
+            std::string sql = builder->select("id, name")->where("status = 'active'")->limit(5)->getSQL();
+            benchSink = sql.size();
+        };
+    });
+}
@@ -0,0 +1,22 @@
+#include "lab_prelude.h"
+
+namespace lab4 {
+#include "../Lab4/main.cpp"
+}
+
+void registerLab4(BenchRegistry& registry) {
+    registry.add("Lab4", "Notification::send (Email)", [] {
+        auto email = std::make_shared<lab4::EmailNotification>("admin@mail.com");
+        return [email] { email->send("Вітання", "Ваш лист доставлено успішно!"); };
+    });
+    registry.add("Lab4", "Notification::send (Slack adapter)", [] {
+        auto service = std::make_shared<lab4::SlackService>("user123", "ABC-KEY-999", "dev-chat");
+        auto slack = std::make_shared<lab4::SlackNotificationAdapter>(service.get());
+        return [service, slack] { slack->send("Нове повідомлення", "Код виконано без помилок."); };
+    });
+    registry.add("Lab4", "Notification::send (SMS adapter)", [] {
+        auto service = std::make_shared<lab4::SmsService>("+380123456789", "System");
+        auto sms = std::make_shared<lab4::SmsNotificationAdapter>(service.get());
+        return [service, sms] { sms->send("Попередження", "Закінчується місце на диску."); };
+    });
+}
@@ -0,0 +1,19 @@
+#include "lab_prelude.h"
+
+namespace lab5 {
+#include "../Lab5/main.cpp"
+}
+
+void registerLab5(BenchRegistry& registry) {
+    registry.add("Lab5", "SimplePage::view (HTML)", [] {
+        auto renderer = std::make_shared<lab5::HTMLRenderer>();
+        auto page = std::make_shared<lab5::SimplePage>(renderer.get(), "About Us", "Welcome to our site!");
+        return [renderer, page] { benchSink = page->view().size(); };
+    });
+    registry.add("Lab5", "ProductPage::view (JSON)", [] {
+        auto renderer = std::make_shared<lab5::JsonRenderer>();
+        auto product = std::make_shared<lab5::Product>("101", "Laptop", "Powerful gaming laptop", "laptop.jpg");
+        auto page = std::make_shared<lab5::ProductPage>(renderer.get(), product.get());
+        return [renderer, product, page] { benchSink = page->view().size(); };
+    });
+}
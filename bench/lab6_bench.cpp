@@ -0,0 +1,28 @@
+#include "lab_prelude.h"
+
+namespace lab6 {
+#include "../Lab6/main.cpp"
+}
+
+void registerLab6(BenchRegistry& registry) {
+    registry.add("Lab6", "CachedDownloader::download (hit)", [] {
+        auto real = std::make_shared<lab6::SimpleDownloader>();
+        auto proxy = std::make_shared<lab6::CachedDownloader>(real.get());
+        proxy->download("http://example.com/file1.txt");
+        return [real, proxy] { benchSink = proxy->download("http://example.com/file1.txt").size(); };
+    });
+    registry.add("Lab6", "CachedDownloader::download (miss)", [] {
+        auto real = std::make_shared<lab6::SimpleDownloader>();
+        auto proxy = std::make_shared<lab6::CachedDownloader>(real.get());
+        return [real, proxy] {
+            proxy->clearCache();
+            benchSink = proxy->download("http://example.com/file1.txt").size();
+        };
+    });
+    registry.add("Lab6", "ParallelChunkDownloader::download (1 MiB, 8 chunks)", [] {
+        auto server = std::make_shared<lab6::SimulatedRangeServer>();
+        server->addFile("http://example.com/big.bin", std::string(1 << 20, 'x'));
+        auto chunked = std::make_shared<lab6::ParallelChunkDownloader>(server.get(), 8, 4);
+        return [server, chunked] { benchSink = chunked->download("http://example.com/big.bin").size(); };
+    });
+}
@@ -0,0 +1,45 @@
+#include "lab_prelude.h"
+
+namespace lab7 {
+#include "../Lab7/main.cpp"
+}
+
+void registerLab7(BenchRegistry& registry) {
+    registry.add("Lab7", "DeliveryStrategy::calculateCost (External)", [] {
+        auto strategy = std::make_shared<lab7::ExternalDeliveryStrategy>();
+        auto distance = std::make_shared<double>(10);
+        return [strategy, distance] {
+            *distance += 0.001;
+            benchSink = (size_t)strategy->calculateCost(*distance, 5);
+        };
+    });
+    registry.add("Lab7", "DeliveryStrategy::calculateCost (Internal)", [] {
+        auto strategy = std::make_shared<lab7::InternalDeliveryStrategy>();
+        auto distance = std::make_shared<double>(10);
+        return [strategy, distance] {
+            *distance += 0.001;
+            benchSink = (size_t)strategy->calculateCost(*distance, 5);
+        };
+    });
+    registry.add("Lab7", "DeliveryStrategy::calculateCosts (1024 parcels)", [] {
+        struct State {
+            lab7::ExternalDeliveryStrategy strategy;
+            std::vector<double> distances, weights, costs;
+        };
+        auto state = std::make_shared<State>();
+        for (size_t i = 0; i < 1024; ++i) {
+            state->distances.push_back(1 + i % 300);
+            state->weights.push_back(0.5 + i % 40);
+        }
+        state->costs.resize(1024);
+        return [state] {
+            state->strategy.calculateCosts(state->distances.data(), state->weights.data(), state->costs.data(), 1024);
+            benchSink = (size_t)state->costs[1023];
+        };
+    });
+    registry.add("Lab7", "DeliveryContext::calculate (External)", [] {
+        auto strategy = std::make_shared<lab7::ExternalDeliveryStrategy>();
+        auto context = std::make_shared<lab7::DeliveryContext>(strategy.get());
+        return [strategy, context] { context->calculate(10, 5); };
+    });
+}
@@ -0,0 +1,30 @@
+#include "lab_prelude.h"
+
+namespace lab8 {
+#include "../Lab8/main.cpp"
+}
+
+void registerLab8(BenchRegistry& registry) {
+    registry.add("Lab8", "EntityUpdater::update (Product)", [] {
+        struct State {
+            lab8::ProductUpdater updater;
+            lab8::Record data = updater.makeRecord();
+            int id = 0;
+        };
+        auto state = std::make_shared<State>();
+        state->updater.setVerbose(false);
+        state->data.set(lab8::ProductFields::Price, "1200");
+        return [state] { state->updater.update(state->id++ % 1000, state->data); };
+    });
+    registry.add("Lab8", "EntityUpdater::update (Order)", [] {
+        struct State {
+            lab8::OrderUpdater updater;
+            lab8::Record data = updater.makeRecord();
+            int id = 0;
+        };
+        auto state = std::make_shared<State>();
+        state->updater.setVerbose(false);
+        state->data.set(lab8::OrderFields::Status, "shipped");
+        return [state] { state->updater.update(state->id++ % 1000, state->data); };
+    });
+}
@@ -0,0 +1,39 @@
+#include "lab_prelude.h"
+
+namespace lab9 {
+#include "../Lab9/main.cpp"
+}
+
+// Одна операція — повний обхід компанії зі 100 000 співробітників
+static const size_t LAB9_EMPLOYEES = 100000;
+
+void registerLab9(BenchRegistry& registry) {
+    registry.add("Lab9", "Visitor traversal (accept/visit, 100k)", [] {
+        std::shared_ptr<lab9::Company> company = lab9::buildSyntheticCompany(LAB9_EMPLOYEES, 200);
+        return [company] {
+            lab9::SalaryTotalVisitor visitor;
+            company->accept(&visitor);
+            benchSink = (size_t)visitor.getTotal();
+        };
+    });
+    registry.add("Lab9", "Static walk traversal (100k)", [] {
+        std::shared_ptr<lab9::Company> company = lab9::buildSyntheticCompany(LAB9_EMPLOYEES, 200);
+        return [company] {
+            double total = 0;
+            lab9::walk(*company, lab9::Overloaded{
+                [](lab9::Company&) {},
+                [](lab9::Department&) {},
+                [&](lab9::Employee& e) { total += e.getSalary(); },
+            });
+            benchSink = (size_t)total;
+        };
+    });
+    registry.add("Lab9", "SalaryAnalyticsVisitor (100k)", [] {
+        std::shared_ptr<lab9::Company> company = lab9::buildSyntheticCompany(LAB9_EMPLOYEES, 200);
+        auto visitor = std::make_shared<lab9::SalaryAnalyticsVisitor>();
+        return [company, visitor] {
+            company->accept(visitor.get());
+            benchSink = visitor->getTotals().count;
+        };
+    });
+}
@@ -0,0 +1,65 @@
+#pragma once
+// Заголовки, які підключають програми LabN/main.cpp. Обгортки бенчмарка
+// підключають main.cpp всередині простору імен labN, тому всі системні
+// заголовки мають бути підключені заздалегідь на глобальному рівні
+// (повторне підключення всередині простору імен зупиняють include guards).
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Спільна телеметрія: одна на весь бенчмарк, а не копія в кожному labN
+#include "../common/telemetry.h"
+
+// Глобальні new/delete задає виконуваний файл бенчмарка (bench/bench.cpp).
+// Лічильники alloc_counter — спільні inline-змінні, тож лабораторні в цій збірці
+// бачать ті самі значення, що й бенчмарк (не нулі)
+#define LAB_NO_ALLOC_HOOKS
+#include "../common/alloc_counter.h"
+
+#include "bench.h"
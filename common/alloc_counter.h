@@ -0,0 +1,57 @@
+#ifndef LABS_COMMON_ALLOC_COUNTER_H
+#define LABS_COMMON_ALLOC_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// === Лічильник виділень пам'яті: замінені глобальні operator new/delete ===
+// Рахує виклики operator new і байти, виділені й ще не звільнені. Оператори
+// визначаються там, де підключено заголовок, тому його підключає лише файл з main().
+// LAB_NO_ALLOC_HOOKS (бібліотечна збірка лабораторних, bench/lab_prelude.h) прибирає
+// оператори: їх один раз визначає bench/bench.cpp, а лічильники — спільні inline-змінні,
+// тож програми лабораторних бачать ті самі значення, що й бенчмарк.
+namespace alloc_counter {
+
+inline std::atomic<size_t> allocations{0};
+inline std::atomic<size_t> bytesInUse{0};
+
+inline size_t allocationCount() { return allocations.load(std::memory_order_relaxed); }
+inline size_t liveBytes() { return bytesInUse.load(std::memory_order_relaxed); }
+
+// Перед блоком зберігається його розмір, щоб delete міг зменшити liveBytes
+constexpr size_t HEADER = alignof(std::max_align_t);
+
+} // namespace alloc_counter
+
+#ifndef LAB_NO_ALLOC_HOOKS
+// Замінені оператори не вбудовуються, щоб GCC не порівнював malloc/free з new/delete
+#if defined(__GNUC__)
+#define ALLOC_NOINLINE __attribute__((noinline))
+#else
+#define ALLOC_NOINLINE
+#endif
+
+ALLOC_NOINLINE void* operator new(size_t size) {
+    alloc_counter::allocations.fetch_add(1, std::memory_order_relaxed);
+    if (char* p = (char*)std::malloc(size + alloc_counter::HEADER)) {
+        *(size_t*)p = size;
+        alloc_counter::bytesInUse.fetch_add(size, std::memory_order_relaxed);
+        return p + alloc_counter::HEADER;
+    }
+    throw std::bad_alloc();
+}
+
+ALLOC_NOINLINE void operator delete(void* p) noexcept {
+    if (!p)
+        return;
+    char* block = (char*)p - alloc_counter::HEADER;
+    alloc_counter::bytesInUse.fetch_sub(*(size_t*)block, std::memory_order_relaxed);
+    std::free(block);
+}
+
+ALLOC_NOINLINE void operator delete(void* p, size_t) noexcept { operator delete(p); }
+#endif
+
+#endif
@@ -0,0 +1,589 @@
+#ifndef LABS_COMMON_TELEMETRY_H
+#define LABS_COMMON_TELEMETRY_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// === Спільний шар телеметрії: журнал, лічильники, гістограми затримок, трасування ===
+// Гарячий шлях пише лише в структури свого потоку: рядки журналу складаються в буфер
+// потоку, події трас — у кільце потоку без блокувань, лічильники і гістограми —
+// у власні комірки потоку.
+// Фоновий потік періодично забирає буфери і виводить їх одним записом, тому
+// виклики не чекають на консоль. Рівень журналу задається під час виконання
+// (setLevel або змінна середовища LAB_LOG_LEVEL=off|error|info|debug);
+// вимкнений рівень коштує одного атомарного читання і розгалуження,
+// так само як і вимкнене вимірювання відрізків (setTiming, LAB_TIMING=off).
+namespace telemetry {
+
+enum class LogLevel : int { Off = 0, Error = 1, Info = 2, Debug = 3 };
+
+namespace detail {
+
+inline bool parseLevel(const std::string& text, LogLevel& level) {
+    static const char* const names[] = {"off", "error", "info", "debug"};
+    for (int i = 0; i < 4; ++i)
+        if (text == names[i]) {
+            level = (LogLevel)i;
+            return true;
+        }
+    return false;
+}
+
+inline int levelFromEnvironment() {
+    const char* env = std::getenv("LAB_LOG_LEVEL");
+    LogLevel level = LogLevel::Info;
+    if (env)
+        parseLevel(env, level);
+    return (int)level;
+}
+
+inline std::atomic<int> currentLevel{levelFromEnvironment()};
+
+inline bool timingFromEnvironment() {
+    const char* env = std::getenv("LAB_TIMING");
+    return !env || std::string(env) != "off";
+}
+
+inline std::atomic<bool> timingEnabled{timingFromEnvironment()};
+
+inline uint64_t nowNs() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+// Лічильник змінює лише потік-власник, тому досить relaxed-читання і запису без lock-префікса
+inline void bump(std::atomic<uint64_t>& cell, uint64_t n) {
+    cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// Гістограма з логарифмічно-лінійними кошиками (похибка ~6%)
+struct HistogramData {
+    static constexpr int SUB_BITS = 4;
+    static constexpr int EXPONENTS = 44;
+    static constexpr size_t BUCKETS = size_t(EXPONENTS) << SUB_BITS;
+
+    std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> maximum{0};
+
+    static int highestBit(uint64_t v) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(v);
+#else
+        int bit = 0;
+        while (v >>= 1) ++bit;
+        return bit;
+#endif
+    }
+
+    static size_t bucketOf(uint64_t v) {
+        if (v < (1u << SUB_BITS))
+            return (size_t)v;
+        int shift = highestBit(v) - SUB_BITS;
+        size_t index = (size_t(shift + 1) << SUB_BITS) + size_t((v >> shift) & ((1u << SUB_BITS) - 1));
+        return std::min(index, BUCKETS - 1);
+    }
+
+    // Середина кошика
+    static uint64_t valueOf(size_t bucket) {
+        if (bucket < (1u << SUB_BITS))
+            return bucket;
+        size_t shift = (bucket >> SUB_BITS) - 1;
+        uint64_t mantissa = (bucket & ((1u << SUB_BITS) - 1)) | (1u << SUB_BITS);
+        return (mantissa << shift) + ((uint64_t(1) << shift) >> 1);
+    }
+
+    void record(uint64_t v) {
+        bump(counts[bucketOf(v)], 1);
+        bump(total, 1);
+        bump(sum, v);
+        if (v > maximum.load(std::memory_order_relaxed))
+            maximum.store(v, std::memory_order_relaxed);
+    }
+};
+
+struct SpanEvent {
+    uint16_t metric;
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+// Кільце відрізків траси: пише лише потік-власник, читає лише експорт.
+// Без блокувань: власник просуває head, експорт — tail. Пам'ять виділяється
+// при першому відрізку потоку. Якщо експорт не встигає і кільце повне,
+// відрізок відкидається і враховується в dropped (видно у зведенні).
+struct SpanRing {
+    static constexpr size_t CAPACITY = 16384; // степінь двійки
+
+    std::atomic<SpanEvent*> events{nullptr};
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+
+    ~SpanRing() { delete[] events.load(); }
+
+    // Повертає true, коли кільце заповнилося наполовину — час розбудити експорт
+    bool push(const SpanEvent& event) {
+        SpanEvent* buffer = events.load(std::memory_order_relaxed);
+        if (!buffer) {
+            buffer = new SpanEvent[CAPACITY];
+            events.store(buffer, std::memory_order_release);
+        }
+        uint64_t h = head.load(std::memory_order_relaxed);
+        uint64_t used = h - tail.load(std::memory_order_acquire);
+        if (used == CAPACITY) {
+            bump(dropped, 1);
+            return false;
+        }
+        buffer[h & (CAPACITY - 1)] = event;
+        head.store(h + 1, std::memory_order_release);
+        return used + 1 == CAPACITY / 2;
+    }
+
+    template <typename F>
+    void drain(F&& consume) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        uint64_t h = head.load(std::memory_order_acquire);
+        if (t == h)
+            return;
+        SpanEvent* buffer = events.load(std::memory_order_acquire);
+        for (; t != h; ++t)
+            consume(buffer[t & (CAPACITY - 1)]);
+        tail.store(t, std::memory_order_release);
+    }
+};
+
+// Стан одного потоку; після завершення потоку передається наступному новому потоку
+struct ThreadState {
+    static constexpr size_t MAX_METRICS = 64;
+
+    uint32_t id = 0;
+    std::array<std::atomic<uint64_t>, MAX_METRICS> counters{};
+    std::array<std::atomic<HistogramData*>, MAX_METRICS> histograms{};
+    SpanRing spans;
+
+    std::mutex linesMutex; // власник проти фонового потоку; конкуренції майже немає
+    std::vector<std::string> lines;
+
+    ~ThreadState() {
+        for (auto& h : histograms)
+            delete h.load();
+    }
+};
+
+} // namespace detail
+
+// "off", "error", "info" або "debug"
+inline bool parseLevel(const std::string& text, LogLevel& level) { return detail::parseLevel(text, level); }
+
+inline void setLevel(LogLevel level) { detail::currentLevel.store((int)level, std::memory_order_relaxed); }
+inline LogLevel getLevel() { return (LogLevel)detail::currentLevel.load(std::memory_order_relaxed); }
+inline bool enabled(LogLevel level) { return (int)level <= detail::currentLevel.load(std::memory_order_relaxed); }
+
+// Вимірювання тривалості відрізків (Span); читання годинника — основна ціна відрізка,
+// тому його можна вимкнути під час виконання (setTiming або LAB_TIMING=off)
+inline void setTiming(bool on) { detail::timingEnabled.store(on, std::memory_order_relaxed); }
+inline bool timing() { return detail::timingEnabled.load(std::memory_order_relaxed); }
+
+// === Реєстр метрик і фоновий експорт ===
+class Telemetry {
+    using ThreadState = detail::ThreadState;
+
+    struct ThreadHandle {
+        ThreadState* state = nullptr;
+        ~ThreadHandle() {
+            if (state)
+                Telemetry::instance().releaseState(state);
+        }
+    };
+
+    std::mutex registryMutex;
+    std::vector<std::string> counterNames;
+    std::vector<std::string> histogramNames;
+    std::vector<std::unique_ptr<ThreadState>> threads;
+    std::vector<ThreadState*> freeStates;
+
+    std::mutex exportMutex; // один експорт за раз: фоновий потік або flush()
+    std::ostream* sink = &std::cout;
+    std::ofstream traceFile;
+    bool traceHasEvents = false;
+    std::vector<std::string> traceNames; // імена гістограм для траси, поповнюються під exportMutex
+    std::atomic<bool> tracing{false};
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> drainRequested{false}; // кільце якогось потоку заповнене наполовину
+    bool stopping = false;
+    std::thread exporter;
+
+    Telemetry() : exporter(&Telemetry::exportLoop, this) {}
+
+    static uint16_t registerName(std::vector<std::string>& names, const std::string& name) {
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it != names.end())
+            return (uint16_t)(it - names.begin());
+        if (names.size() == ThreadState::MAX_METRICS)
+            throw std::length_error("Забагато метрик: " + name);
+        names.push_back(name);
+        return (uint16_t)(names.size() - 1);
+    }
+
+    ThreadState* acquireState() {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (!freeStates.empty()) {
+            ThreadState* state = freeStates.back();
+            freeStates.pop_back();
+            return state;
+        }
+        threads.push_back(std::make_unique<ThreadState>());
+        threads.back()->id = (uint32_t)threads.size();
+        return threads.back().get();
+    }
+
+    void releaseState(ThreadState* state) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        freeStates.push_back(state);
+    }
+
+    void exportLoop() {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!stopping) {
+            wake.wait_for(lock, std::chrono::milliseconds(50),
+                          [&] { return stopping || drainRequested.exchange(false); });
+            lock.unlock();
+            // Поки потоки встигають наповнювати кільця, експорт не засинає
+            while (drain() >= detail::SpanRing::CAPACITY / 4)
+                ;
+            lock.lock();
+        }
+    }
+
+    // Забирає буфери всіх потоків і виводить їх одним записом;
+    // повертає найбільшу кількість відрізків, забраних з одного кільця
+    size_t drain() {
+        std::lock_guard<std::mutex> exportLock(exportMutex);
+        std::string text;
+        std::vector<std::pair<uint32_t, detail::SpanEvent>> spans;
+        size_t busiest = 0;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (auto& state : threads) {
+                {
+                    std::lock_guard<std::mutex> linesLock(state->linesMutex);
+                    for (auto& line : state->lines)
+                        text += line;
+                    state->lines.clear();
+                }
+                uint32_t tid = state->id;
+                size_t before = spans.size();
+                state->spans.drain([&](const detail::SpanEvent& span) { spans.emplace_back(tid, span); });
+                busiest = std::max(busiest, spans.size() - before);
+            }
+            // Імена нових метрик копіюються один раз; далі траса бере їх без реєстру
+            if (!spans.empty() && traceNames.size() < histogramNames.size())
+                traceNames.assign(histogramNames.begin(), histogramNames.end());
+        }
+        if (!text.empty()) {
+            sink->write(text.data(), (std::streamsize)text.size());
+            sink->flush();
+        }
+        if (traceFile.is_open()) {
+            // Мікросекунди з трьома знаками — цілочисельно, без форматування double потоком
+            std::string json;
+            auto appendMicros = [&json](uint64_t ns) {
+                char digits[24];
+                json += std::to_string(ns / 1000);
+                int n = std::snprintf(digits, sizeof digits, ".%03u", (unsigned)(ns % 1000));
+                json.append(digits, (size_t)n);
+            };
+            for (auto& entry : spans) {
+                const detail::SpanEvent& span = entry.second;
+                json += traceHasEvents ? ",\n{\"name\": \"" : "{\"name\": \"";
+                json += traceNames[span.metric];
+                json += "\", \"ph\": \"X\", \"pid\": 1, \"tid\": ";
+                json += std::to_string(entry.first);
+                json += ", \"ts\": ";
+                appendMicros(span.startNs);
+                json += ", \"dur\": ";
+                appendMicros(span.durationNs);
+                json += "}";
+                traceHasEvents = true;
+            }
+            traceFile.write(json.data(), (std::streamsize)json.size());
+            traceFile.flush();
+        }
+        return busiest;
+    }
+
+public:
+    static Telemetry& instance() {
+        static Telemetry telemetry;
+        return telemetry;
+    }
+
+    ~Telemetry() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        exporter.join();
+        stopTrace();
+        drain();
+    }
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    uint16_t registerCounter(const std::string& name) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        return registerName(counterNames, name);
+    }
+
+    uint16_t registerHistogram(const std::string& name) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        return registerName(histogramNames, name);
+    }
+
+    ThreadState& local() {
+        thread_local ThreadHandle handle;
+        if (!handle.state)
+            handle.state = acquireState();
+        return *handle.state;
+    }
+
+    void appendLine(std::string line) {
+        ThreadState& state = local();
+        std::lock_guard<std::mutex> lock(state.linesMutex);
+        state.lines.push_back(std::move(line));
+    }
+
+    // Без блокувань: запис у кільце свого потоку
+    void appendSpan(uint16_t metric, uint64_t startNs, uint64_t durationNs) {
+        if (local().spans.push({metric, startNs, durationNs})) {
+            drainRequested.store(true, std::memory_order_relaxed);
+            wake.notify_one();
+        }
+    }
+
+    bool isTracing() const { return tracing.load(std::memory_order_relaxed); }
+
+    // Виводить усе накопичене; потрібно перед прямим записом у консоль
+    void flush() { drain(); }
+
+    // Куди виводити журнал (за замовчуванням std::cout)
+    void setSink(std::ostream& out) {
+        drain();
+        std::lock_guard<std::mutex> lock(exportMutex);
+        sink = &out;
+    }
+
+    // Трасування у форматі Chrome trace (chrome://tracing, Perfetto)
+    bool startTrace(const std::string& path) {
+        drain();
+        std::lock_guard<std::mutex> lock(exportMutex);
+        traceFile.open(path);
+        if (!traceFile)
+            return false;
+        traceFile.setf(std::ios::fixed);
+        traceFile.precision(3);
+        traceFile << "[\n";
+        traceHasEvents = false;
+        tracing = true;
+        return true;
+    }
+
+    void stopTrace() {
+        tracing = false;
+        drain();
+        std::lock_guard<std::mutex> lock(exportMutex);
+        if (traceFile.is_open()) {
+            traceFile << "\n]\n";
+            traceFile.close();
+        }
+    }
+
+    // Зведення лічильників і гістограм по всіх потоках
+    void report(std::ostream& out) {
+        drain();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        out << "[Телеметрія]\n";
+        for (size_t c = 0; c < counterNames.size(); ++c) {
+            uint64_t total = 0;
+            for (auto& state : threads)
+                total += state->counters[c].load(std::memory_order_relaxed);
+            out << "  " << counterNames[c] << ": " << total << "\n";
+        }
+        uint64_t droppedSpans = 0;
+        for (auto& state : threads)
+            droppedSpans += state->spans.dropped.load(std::memory_order_relaxed);
+        if (droppedSpans)
+            out << "  відкинуто відрізків траси (кільце потоку повне): " << droppedSpans << "\n";
+        for (size_t h = 0; h < histogramNames.size(); ++h) {
+            std::vector<uint64_t> counts(detail::HistogramData::BUCKETS, 0);
+            uint64_t total = 0, sum = 0, maximum = 0;
+            for (auto& state : threads) {
+                detail::HistogramData* data = state->histograms[h].load(std::memory_order_acquire);
+                if (!data)
+                    continue;
+                for (size_t b = 0; b < counts.size(); ++b)
+                    counts[b] += data->counts[b].load(std::memory_order_relaxed);
+                total += data->total.load(std::memory_order_relaxed);
+                sum += data->sum.load(std::memory_order_relaxed);
+                maximum = std::max(maximum, data->maximum.load(std::memory_order_relaxed));
+            }
+            if (total == 0)
+                continue;
+            // Ранг найближчого значення; середина кошика не більша за максимум
+            auto percentile = [&](double q) {
+                uint64_t rank = std::max<uint64_t>((uint64_t)std::ceil(q * total), 1), seen = 0;
+                for (size_t b = 0; b < counts.size(); ++b)
+                    if ((seen += counts[b]) >= rank)
+                        return std::min(detail::HistogramData::valueOf(b), maximum);
+                return maximum;
+            };
+            out << "  " << histogramNames[h] << ": " << total << " вимірів, середнє " << sum / total
+                << " нс, p50 " << percentile(0.5) << " нс, p99 " << percentile(0.99) << " нс, макс " << maximum
+                << " нс\n";
+        }
+    }
+};
+
+// === Лічильник ===
+class Counter {
+    uint16_t id;
+
+public:
+    explicit Counter(const std::string& name) : id(Telemetry::instance().registerCounter(name)) {}
+
+    void add(uint64_t n = 1) const { detail::bump(Telemetry::instance().local().counters[id], n); }
+};
+
+// === Гістограма затримок, нс ===
+class Histogram {
+    uint16_t id;
+
+public:
+    explicit Histogram(const std::string& name) : id(Telemetry::instance().registerHistogram(name)) {}
+
+    uint16_t getId() const { return id; }
+
+    void record(uint64_t ns) const {
+        auto& slot = Telemetry::instance().local().histograms[id];
+        detail::HistogramData* data = slot.load(std::memory_order_relaxed);
+        if (!data) {
+            data = new detail::HistogramData();
+            slot.store(data, std::memory_order_release);
+        }
+        data->record(ns);
+    }
+};
+
+// === Відрізок трасування: тривалість області видимості йде в гістограму ===
+// Якщо трасування ввімкнено (startTrace), відрізок також потрапляє в файл траси.
+class Span {
+    const Histogram& histogram;
+    bool active;
+    uint64_t start;
+
+public:
+    explicit Span(const Histogram& h) : histogram(h), active(timing()), start(active ? detail::nowNs() : 0) {}
+
+    ~Span() {
+        if (!active)
+            return;
+        uint64_t duration = detail::nowNs() - start;
+        histogram.record(duration);
+        if (Telemetry::instance().isTracing())
+            Telemetry::instance().appendSpan(histogram.getId(), start, duration);
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+};
+
+// === Рядок журналу ===
+// Форматується в буфер потоку і передається фоновому виводу в деструкторі.
+// Якщо аргумент рядка сам пише в журнал, вкладений рядок отримує власний буфер,
+// інакше він затер би ще не дописаний зовнішній.
+class LogLine {
+    struct ThreadBuffer {
+        std::ostringstream os;
+        bool busy = false;
+    };
+
+    std::unique_ptr<std::ostringstream> nested;
+    std::ostringstream* out;
+
+    static ThreadBuffer& buffer() {
+        thread_local ThreadBuffer b;
+        return b;
+    }
+
+public:
+    LogLine() {
+        ThreadBuffer& b = buffer();
+        if (b.busy) {
+            nested = std::make_unique<std::ostringstream>();
+            out = nested.get();
+            return;
+        }
+        b.busy = true;
+        out = &b.os;
+        out->str("");
+        out->clear();
+    }
+
+    ~LogLine() {
+        Telemetry::instance().appendLine(out->str());
+        if (!nested)
+            buffer().busy = false;
+    }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    template <typename T>
+    LogLine& operator<<(const T& value) {
+        *out << value;
+        return *this;
+    }
+
+    LogLine& operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+        *out << manipulator;
+        return *this;
+    }
+};
+
+struct LogVoidify {
+    void operator&(const LogLine&) const {}
+};
+
+inline void flush() { Telemetry::instance().flush(); }
+
+} // namespace telemetry
+
+// Рядок журналу заданого рівня: TLOG(Info) << "..." << value << endl;
+// Якщо рівень вимкнено, аргументи навіть не обчислюються.
+#define TLOG_AT(level) \
+    !::telemetry::enabled(level) ? (void)0 : ::telemetry::LogVoidify() & ::telemetry::LogLine()
+#define TLOG(level) TLOG_AT(::telemetry::LogLevel::level)
+
+#endif